@@ -1,12 +1,52 @@
 // src/game/collision.c
 #include "game/collision.h"
+#include "world/coll_rects.h"
 #include "world/layered_map.h"
 
+// Boxes covering at least this many tiles ask the map's merged collision
+// rects or summed-area table (near constant time, but a few cache misses)
+// instead of scanning rows.
+#define COLLISION_BIG_BOX_TILES 36
+
 static int i_floor_div(float v, int tile_size)
 {
     return (int)(v / (float)tile_size); // world coords are non-negative in your engine
 }
 
+// Any solid tile in [tx0,tx1] x [ty0,ty1]? Big boxes inside the map ask the
+// merged rects or the summed-area table, small ones scan rows; boxes
+// crossing the edge (outside is solid) are checked per tile.
+static bool any_solid(const LayeredMap* m, int tx0, int ty0, int tx1, int ty1)
+{
+    if (tx0 >= 0 && ty0 >= 0 && tx1 < m->width && ty1 < m->height)
+    {
+        if ((tx1 - tx0 + 1) * (ty1 - ty0 + 1) >= COLLISION_BIG_BOX_TILES)
+        {
+            const CollRects* rects = LayeredMap_CollRects(m);
+            if (rects) return CollRects_Any(rects, tx0, ty0, tx1 + 1, ty1 + 1);
+            if (m->coll_table) return !LayeredMap_RectClear(m, tx0, ty0, tx1 + 1, ty1 + 1);
+        }
+
+        int buf[LAYERED_MAP_SPAN_MAX];
+        for (int ty = ty0; ty <= ty1; ++ty)
+        {
+            for (int x0 = tx0; x0 <= tx1; x0 += LAYERED_MAP_SPAN_MAX)
+            {
+                const int count = SDL_min(tx1 + 1 - x0, LAYERED_MAP_SPAN_MAX);
+                const int* row = LayeredMap_Row(m, MAP_LAYER_COLL, x0, ty, count, buf);
+                for (int i = 0; i < count; ++i)
+                    if (row[i]) return true;
+            }
+        }
+        return false;
+    }
+
+    for (int ty = ty0; ty <= ty1; ++ty)
+        for (int tx = tx0; tx <= tx1; ++tx)
+            if (LayeredMap_Solid(m, tx, ty)) return true;
+    return false;
+}
+
 static bool rect_collides_tiles(const LayeredMap* m, const SDL_FRect* r)
 {
     if (!m || !r) return true;
@@ -20,15 +60,7 @@ static bool rect_collides_tiles(const LayeredMap* m, const SDL_FRect* r)
     const int tx1 = i_floor_div(r->x + r->w - eps, ts);
     const int ty1 = i_floor_div(r->y + r->h - eps, ts);
 
-    for (int ty = ty0; ty <= ty1; ++ty)
-    {
-        for (int tx = tx0; tx <= tx1; ++tx)
-        {
-            if (LayeredMap_Solid(m, tx, ty))
-                return true;
-        }
-    }
-    return false;
+    return any_solid(m, tx0, ty0, tx1, ty1);
 }
 
 static void resolve_x(const LayeredMap* m, SDL_FRect* r, float dx)
@@ -46,14 +78,8 @@ static void resolve_x(const LayeredMap* m, SDL_FRect* r, float dx)
         const int ty0 = i_floor_div(r->y, ts);
         const int ty1 = i_floor_div(r->y + r->h - eps, ts);
 
-        for (int ty = ty0; ty <= ty1; ++ty)
-        {
-            if (LayeredMap_Solid(m, tx, ty))
-            {
-                r->x = (float)(tx * ts) - r->w; // snap flush
-                return;
-            }
-        }
+        if (any_solid(m, tx, ty0, tx, ty1))
+            r->x = (float)(tx * ts) - r->w; // snap flush
     }
     else if (dx < 0.0f)
     {
@@ -64,14 +90,8 @@ static void resolve_x(const LayeredMap* m, SDL_FRect* r, float dx)
         const int ty0 = i_floor_div(r->y, ts);
         const int ty1 = i_floor_div(r->y + r->h - eps, ts);
 
-        for (int ty = ty0; ty <= ty1; ++ty)
-        {
-            if (LayeredMap_Solid(m, tx, ty))
-            {
-                r->x = (float)((tx + 1) * ts); // snap flush
-                return;
-            }
-        }
+        if (any_solid(m, tx, ty0, tx, ty1))
+            r->x = (float)((tx + 1) * ts); // snap flush
     }
 }
 
@@ -90,14 +110,8 @@ static void resolve_y(const LayeredMap* m, SDL_FRect* r, float dy)
         const int tx0 = i_floor_div(r->x, ts);
         const int tx1 = i_floor_div(r->x + r->w - eps, ts);
 
-        for (int tx = tx0; tx <= tx1; ++tx)
-        {
-            if (LayeredMap_Solid(m, tx, ty))
-            {
-                r->y = (float)(ty * ts) - r->h;
-                return;
-            }
-        }
+        if (any_solid(m, tx0, ty, tx1, ty))
+            r->y = (float)(ty * ts) - r->h;
     }
     else if (dy < 0.0f)
     {
@@ -108,14 +122,8 @@ static void resolve_y(const LayeredMap* m, SDL_FRect* r, float dy)
         const int tx0 = i_floor_div(r->x, ts);
         const int tx1 = i_floor_div(r->x + r->w - eps, ts);
 
-        for (int tx = tx0; tx <= tx1; ++tx)
-        {
-            if (LayeredMap_Solid(m, tx, ty))
-            {
-                r->y = (float)((ty + 1) * ts);
-                return;
-            }
-        }
+        if (any_solid(m, tx0, ty, tx1, ty))
+            r->y = (float)((ty + 1) * ts);
     }
 }
 
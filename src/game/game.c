@@ -5,63 +5,222 @@
 #include <string.h>
 
 #include <SDL3/SDL.h>
-#include <SDL3_image/SDL_image.h>
 
 #include "platform/platform_app.h"
+#include "render/atlas.h"
+#include "render/chunk_cache.h"
+#include "render/rect_batch.h"
+#include "render/tile_batch.h"
+#include "ui/text_cache.h"
+#include "ui/ui_text.h"
+#include "world/autotile.h"
+#include "world/coll_rects.h"
 #include "world/layered_map.h"
+#include "world/map_cache.h"
+#include "world/map_preload.h"
+#include "world/map_stream.h"
+#include "world/map_watch.h"
+#include "world/sparse_layer.h"
+#include "world/tile_props.h"
 #include "game/collision.h"
 #include "game/entity.h"
 #include "game/entity_system.h"
 
 // ------------------------------------------------------------
-// Tileset
+// Tileset + sprite sheets
 // ------------------------------------------------------------
-static SDL_Texture* g_tiles_tex = NULL;
-static int g_tiles_cols = 0;
 
+// Player sheet: 3 frames per row, one row per PlayerFacing
+#define PLAYER_SHEET_PATH  "assets/sprites/player.png"
+#define PLAYER_FRAME_PX    32
+#define PLAYER_SHEET_COLS  3
+
+// Tileset first, so map tile ids are atlas ids
+static Atlas g_atlas;
+static int g_player_frames = 0;   // first atlas id of the player sheet, 0 = none
+static int g_atlas_ts = 0;        // tile size the tileset was cut at
+
+// Tiles of a layer go out in one SDL_RenderGeometry call
+static TileBatch g_tile_batch;
+
+// Same-colored rects (wall placeholders, debug overlay) go out together
+static RectBatch g_rect_batch;
+
+// Properties of the tileset's ids (solid, opaque, ...)
+static TileProps g_tile_props;
+
+static void Tiles_Unload(void);
+
+// Cells are drawn at the size they were cut at, so a map with another tile
+// size needs the tileset cut again.
 static bool Tiles_Load(SDL_Renderer* r, const char* path, int tile_size)
 {
-    if (g_tiles_tex) return true;
+    if (g_atlas.page_count > 0 && g_atlas_ts == tile_size) return true;
+    if (tile_size <= 0) return false;
 
-    g_tiles_tex = IMG_LoadTexture(r, path);
-    if (!g_tiles_tex)
+    Tiles_Unload();
+    if (Atlas_AddImage(&g_atlas, "tiles", path, tile_size, tile_size) != 1) return false;
+
+    // Optional: without it the player stays a plain rect
+    g_player_frames = Atlas_AddImage(&g_atlas, "player", PLAYER_SHEET_PATH, PLAYER_FRAME_PX, PLAYER_FRAME_PX);
+
+    if (!Atlas_Build(&g_atlas, r))
     {
-        SDL_Log("IMG_LoadTexture failed: %s (%s)", path, SDL_GetError());
+        g_player_frames = 0;
         return false;
     }
+    g_atlas_ts = tile_size;
+    return true;
+}
 
-    float tw = 0.0f, th = 0.0f;
-    SDL_GetTextureSize(g_tiles_tex, &tw, &th);
+static void Tiles_Unload(void)
+{
+    Atlas_Destroy(&g_atlas);
+    g_player_frames = 0;
+    g_atlas_ts = 0;
+    TileBatch_Free(&g_tile_batch);
+}
 
-    if (tile_size <= 0) return false;
-    g_tiles_cols = (int)(tw / (float)tile_size);
+// Queued; the layer is submitted with TileBatch_Flush
+static void Draw_Tile(int tile_id, float dx, float dy)
+{
+    TileBatch_Add(&g_tile_batch, tile_id, dx, dy);
+}
 
-    return (g_tiles_cols > 0);
+// One layer drawn over the visible rect with LayeredMap_VisitRect
+typedef struct TilePass
+{
+    SDL_Renderer* r;
+    int ts;
+    float cam_x, cam_y;
+    float off_x, off_y;
+    const Autotile* autotile;   // deco pass only
+} TilePass;
+
+static bool Draw_TileRow(void* user, int tx0, int ty, const int* row, int count)
+{
+    const TilePass* p = (const TilePass*)user;
+    const float dy = (float)(ty * p->ts) - p->cam_y + p->off_y;
+    for (int i = 0; i < count; ++i)
+    {
+        const float dx = (float)((tx0 + i) * p->ts) - p->cam_x + p->off_x;
+        Draw_Tile(row[i], dx, dy);
+    }
+    return true;
 }
 
-static void Tiles_Unload(void)
+// Deco row: autotiled ids draw the variant picked by their precomputed mask
+static bool Draw_DecoRow(void* user, int tx0, int ty, const int* row, int count)
 {
-    if (g_tiles_tex)
+    const TilePass* p = (const TilePass*)user;
+    if (!p->autotile) return Draw_TileRow(user, tx0, ty, row, count);
+
+    const uint8_t* mask = Autotile_Row(p->autotile, tx0, ty);
+    const float dy = (float)(ty * p->ts) - p->cam_y + p->off_y;
+    for (int i = 0; i < count; ++i)
     {
-        SDL_DestroyTexture(g_tiles_tex);
-        g_tiles_tex = NULL;
+        const float dx = (float)((tx0 + i) * p->ts) - p->cam_x + p->off_x;
+        Draw_Tile(TileProps_AutotileId(p->autotile->props, row[i], mask[i]), dx, dy);
     }
-    g_tiles_cols = 0;
+    return true;
 }
 
-static void Draw_Tile(SDL_Renderer* r, int tile_id, int ts, float dx, float dy)
+// Every non-zero tile, onto the rect batch
+static bool Fill_TileRow(void* user, int tx0, int ty, const int* row, int count)
 {
-    if (!g_tiles_tex) return;
-    if (tile_id <= 0) return;
+    const TilePass* p = (const TilePass*)user;
+    const float dy = (float)(ty * p->ts) - p->cam_y + p->off_y;
+    for (int i = 0; i < count; ++i)
+    {
+        if (!row[i]) continue;
+        RectBatch_Add(&g_rect_batch, (float)((tx0 + i) * p->ts) - p->cam_x + p->off_x, dy, (float)p->ts, (float)p->ts);
+    }
+    return true;
+}
+
+// Debug overlay: one rect per merged collision rect (batch fills and outlines)
+static bool Fill_CollRect(void* user, const CollRect* c)
+{
+    const TilePass* p = (const TilePass*)user;
+    RectBatch_Add(&g_rect_batch,
+                  (float)(c->tx * p->ts) - p->cam_x + p->off_x,
+                  (float)(c->ty * p->ts) - p->cam_y + p->off_y,
+                  (float)(c->tw * p->ts),
+                  (float)(c->th * p->ts));
+    return true;
+}
+
+// Static layers (ground, deco, wall placeholders) of a tile rect; what the
+// chunk cache renders into its textures. Screen = world - (org_x, org_y).
+typedef struct StaticPass
+{
+    const LayeredMap* m;
+    const TileProps* props;
+} StaticPass;
+
+static void Draw_StaticLayers(void* user, SDL_Renderer* r,
+                              int tx0, int ty0, int tx1, int ty1,
+                              float org_x, float org_y)
+{
+    const StaticPass* sp = (const StaticPass*)user;
+    const LayeredMap* m = sp->m;
+    const int ts = m->tile_size;
+
+    TilePass pass = { r, ts, org_x, org_y, 0.0f, 0.0f, NULL };
+    TileBatch_Begin(&g_tile_batch, r, &g_atlas);
 
-    const int idx = tile_id - 1;
-    const int sx = (idx % g_tiles_cols) * ts;
-    const int sy = (idx / g_tiles_cols) * ts;
+    // Ground
+    LayeredMap_VisitRect(m, MAP_LAYER_GROUND, tx0, ty0, tx1, ty1, Draw_TileRow, &pass);
+    TileBatch_Flush(&g_tile_batch);
+
+    // Deco (sparse layers only visit their set cells)
+    const SparseLayer* deco_sparse = LayeredMap_SparseLayer(m, MAP_LAYER_DECO);
+    if (deco_sparse)
+    {
+        int first = 0;
+        const int count = SparseLayer_RowRange(deco_sparse, ty0, ty1, &first);
+        for (int i = 0; i < count; ++i)
+        {
+            const SparseCell* c = &deco_sparse->cells[first + i];
+            if (c->tx < tx0 || c->tx >= tx1) continue;
+
+            const float dx = (float)(c->tx * ts) - org_x;
+            const float dy = (float)(c->ty * ts) - org_y;
+            const int id = m->autotile
+                ? TileProps_AutotileId(m->autotile->props, c->value, *Autotile_Row(m->autotile, c->tx, c->ty))
+                : c->value;
+            Draw_Tile(id, dx, dy);
+        }
+    }
+    else
+    {
+        pass.autotile = m->autotile;
+        LayeredMap_VisitRect(m, MAP_LAYER_DECO, tx0, ty0, tx1, ty1, Draw_DecoRow, &pass);
+    }
+    TileBatch_Flush(&g_tile_batch);
+
+    // Coll placeholder: solid cells whose deco art does not cover the cell
+    const SDL_Color wall = { 70, 70, 90, 255 };
+    RectBatch_Begin(&g_rect_batch, r, RECT_BATCH_FILL, wall);
+    int solid_buf[LAYERED_MAP_SPAN_MAX], deco_buf[LAYERED_MAP_SPAN_MAX];
+    for (int ty = ty0; ty < ty1; ++ty)
+    {
+        for (int x0 = tx0; x0 < tx1; x0 += LAYERED_MAP_SPAN_MAX)
+        {
+            const int count = SDL_min(tx1 - x0, LAYERED_MAP_SPAN_MAX);
+            const int* solid = LayeredMap_Row(m, MAP_LAYER_COLL, x0, ty, count, solid_buf);
+            const int* deco = LayeredMap_Row(m, MAP_LAYER_DECO, x0, ty, count, deco_buf);
 
-    SDL_FRect src = { (float)sx, (float)sy, (float)ts, (float)ts };
-    SDL_FRect dst = { dx, dy, (float)ts, (float)ts };
+            for (int i = 0; i < count; ++i)
+            {
+                const int covered = (TileProps_Flags(sp->props, deco[i]) & TILE_OPAQUE) != 0;
+                if (!(solid[i] & !covered)) continue;
 
-    SDL_RenderTexture(r, g_tiles_tex, &src, &dst);
+                RectBatch_Add(&g_rect_batch, (float)((x0 + i) * ts) - org_x, (float)(ty * ts) - org_y, (float)ts, (float)ts);
+            }
+        }
+    }
+    RectBatch_Flush(&g_rect_batch);
 }
 
 // ------------------------------------------------------------
@@ -91,6 +250,20 @@ static void Calc_Camera(const LayeredMap* m,
     *out_cam_y = cy;
 }
 
+// ------------------------------------------------------------
+// Chunked maps: keep the chunks around the camera resident
+// ------------------------------------------------------------
+static void Stream_Map(Game* g, const PlatformApp* app)
+{
+    if (!g->map->stream) return;
+
+    float cam_x = 0.0f, cam_y = 0.0f;
+    Calc_Camera(g->map, g->player_x, g->player_y, app->win_w, app->win_h, &cam_x, &cam_y);
+
+    MapStream_Update(g->map, cam_x, cam_y, (float)app->win_w, (float)app->win_h,
+                     g->player_vx, g->player_vy);
+}
+
 // ------------------------------------------------------------
 // Player movement: tile collision + sliding + entity solids
 // ------------------------------------------------------------
@@ -151,18 +324,8 @@ static void Move_Player_Entity(Game* g, const PlatformApp* app, double dt)
 // ------------------------------------------------------------
 // Door system: load map + respawn entities
 // ------------------------------------------------------------
-static bool Game_LoadMapAndRespawn(Game* g, const char* map_path, float spawn_x, float spawn_y)
+static void Game_Respawn(Game* g, const char* map_path, float spawn_x, float spawn_y)
 {
-    if (!g || !g->map || !map_path) return false;
-
-    // Load map into existing LayeredMap struct
-    LayeredMap_Shutdown(g->map);
-    if (!LayeredMap_LoadFromFile(g->map, map_path))
-    {
-        SDL_Log("LoadMap failed: %s", map_path);
-        return false;
-    }
-
     SDL_strlcpy(g->current_map, map_path, sizeof(g->current_map));
 
     // Reset systems that depend on the map
@@ -217,9 +380,140 @@ static bool Game_LoadMapAndRespawn(Game* g, const char* map_path, float spawn_x,
     }
 
     SDL_Log("Loaded map: %s (spawn %.1f,%.1f)", g->current_map, spawn_x, spawn_y);
+}
+
+static bool Game_LoadMap(const char* map_path, LayeredMap* out)
+{
+    if (!LayeredMap_LoadFromFile(out, map_path))
+    {
+        SDL_Log("LoadMap failed: %s", map_path);
+        return false;
+    }
+
+    // Compact tile storage: 4x smaller, collision reads hit a bitset.
+    // Streamed maps and ids that do not fit stay as they are.
+    (void)LayeredMap_Pack(out);
+    return true;
+}
+
+// Make *next the active map and respawn. The map being left is kept in the
+// cache for the trip back.
+static void Game_EnterMap(Game* g, LayeredMap* next, const char* map_path, float spawn_x, float spawn_y)
+{
+    if (g->map_cache && g->map->width > 0)
+        MapCache_Put(g->map_cache, g->current_map, g->map);
+    else
+        LayeredMap_Shutdown(g->map);
+
+    *g->map = *next;
+    memset(next, 0, sizeof(*next));
+    ChunkCache_Clear(g->chunks);
+
+    Game_Respawn(g, map_path, spawn_x, spawn_y);
+
+    // Streamed maps come from compiled files only; nothing to hot reload
+    MapWatch_SetFile(g->watch, g->map->stream ? "" : g->current_map);
+
+    if (g->map_cache)
+    {
+        MapCacheStats st;
+        MapCache_GetStats(g->map_cache, &st);
+        SDL_Log("Map cache: %u hits, %u misses, %u evictions; %d maps, %zu/%zu KiB",
+                st.hits, st.misses, st.evictions, st.count, st.bytes / 1024, st.budget / 1024);
+    }
+
+    TextCacheStats ts;
+    UIText_GetCacheStats(&ts);
+    if (ts.hits + ts.misses > 0)
+        SDL_Log("UI text cache: %u hits, %u misses (%.1f%% hit rate), %u evictions; %d strings, %zu/%zu KiB",
+                ts.hits, ts.misses, 100.0 * ts.hits / (double)(ts.hits + ts.misses), ts.evictions,
+                ts.count, ts.bytes / 1024, ts.budget / 1024);
+}
+
+static bool Game_LoadMapAndRespawn(Game* g, const char* map_path, float spawn_x, float spawn_y)
+{
+    if (!g || !g->map || !map_path) return false;
+
+    LayeredMap next;
+    memset(&next, 0, sizeof(next));
+    if (!MapCache_Take(g->map_cache, map_path, &next) && !Game_LoadMap(map_path, &next))
+        return false;
+
+    Game_EnterMap(g, &next, map_path, spawn_x, spawn_y);
     return true;
 }
 
+// Start loading the target of the nearest door within reach, so using it
+// later only swaps maps.
+#define DOOR_PRELOAD_RADIUS_TILES 6.0f
+
+static void Door_PreloadNearby(Game* g)
+{
+    if (!g->preload) return;
+
+    Entity* p = EntitySystem_FindById(&g->ents, g->player_eid);
+    if (!p) return;
+
+    const float r = DOOR_PRELOAD_RADIUS_TILES * (float)g->map->tile_size;
+    float best_d2 = r * r;
+    const Entity* best = NULL;
+
+    for (int i = 0; i < ENTITY_MAX; ++i)
+    {
+        const Entity* e = &g->ents.entities[i];
+        if (!e->alive || e->type != ENT_DOOR || e->door_target_map[0] == '\0') continue;
+
+        const float dx = e->x - p->x;
+        const float dy = e->y - p->y;
+        const float d2 = dx * dx + dy * dy;
+        if (d2 < best_d2)
+        {
+            best_d2 = d2;
+            best = e;
+        }
+    }
+
+    if (best &&
+        SDL_strcmp(best->door_target_map, g->current_map) != 0 &&
+        !MapCache_Contains(g->map_cache, best->door_target_map))
+    {
+        MapPreload_Request(g->preload, best->door_target_map);
+    }
+}
+
+// Swap in the used door's map once the worker has it; never waits.
+static void Door_FinishTransition(Game* g)
+{
+    if (!g->door_pending) return;
+
+    switch (MapPreload_State(g->preload, g->door_pending_map))
+    {
+    case MAP_PRELOAD_READY:
+    {
+        const Uint64 t0 = SDL_GetTicksNS();
+
+        LayeredMap next;
+        memset(&next, 0, sizeof(next));
+        if (!MapPreload_Take(g->preload, g->door_pending_map, &next)) return;
+
+        g->door_pending = false;
+        Game_EnterMap(g, &next, g->door_pending_map, g->door_pending_x, g->door_pending_y);
+
+        SDL_Log("Door transition: swapped in %.3f ms", (double)(SDL_GetTicksNS() - t0) / 1e6);
+        break;
+    }
+    case MAP_PRELOAD_FAILED:
+        SDL_Log("LoadMap failed: %s", g->door_pending_map);
+        g->door_pending = false;
+        break;
+    case MAP_PRELOAD_IDLE:
+        MapPreload_Request(g->preload, g->door_pending_map);
+        break;
+    case MAP_PRELOAD_LOADING:
+        break;
+    }
+}
+
 static void Door_TryUseNearest(Game* g, PlatformApp* app)
 {
     if (!g || !app || !g->map) return;
@@ -238,7 +532,69 @@ static void Door_TryUseNearest(Game* g, PlatformApp* app)
         return;
     }
 
-    (void)Game_LoadMapAndRespawn(g, near->door_target_map, near->door_spawn_x, near->door_spawn_y);
+    // Cached maps (or every map without the worker) swap in right away
+    LayeredMap next;
+    memset(&next, 0, sizeof(next));
+    if (MapCache_Take(g->map_cache, near->door_target_map, &next) ||
+        (!g->preload && Game_LoadMap(near->door_target_map, &next)))
+    {
+        Game_EnterMap(g, &next, near->door_target_map, near->door_spawn_x, near->door_spawn_y);
+        return;
+    }
+    if (!g->preload) return;
+
+    // Copy first: the door entity goes away with the respawn.
+    SDL_strlcpy(g->door_pending_map, near->door_target_map, sizeof(g->door_pending_map));
+    g->door_pending_x = near->door_spawn_x;
+    g->door_pending_y = near->door_spawn_y;
+    g->door_pending = true;
+
+    MapPreload_Request(g->preload, g->door_pending_map);
+    Door_FinishTransition(g);
+}
+
+// ------------------------------------------------------------
+// Hot reload: saved edits land in the live map, entities stay
+// ------------------------------------------------------------
+static void Map_HotReload(Game* g)
+{
+    if (!g->watch) return;
+
+    // Other maps were saved: drop copies that are now stale
+    char path[256];
+    while (MapWatch_NextChanged(g->watch, path, sizeof(path)))
+    {
+        MapCache_Drop(g->map_cache, path);
+        MapPreload_Invalidate(g->preload, path);
+    }
+
+    LayeredMap next;
+    memset(&next, 0, sizeof(next));
+    if (!MapWatch_TakeReload(g->watch, &next)) return;
+
+    const Uint64 t0 = SDL_GetTicksNS();
+    const int changed = LayeredMap_ApplyDiff(g->map, &next);
+    if (changed < 0)
+    {
+        // Resized, or a value no longer fits packed storage: swap the
+        // storage but keep entities and the player where they are
+        (void)LayeredMap_Pack(&next);
+        (void)LayeredMap_BuildCollTable(&next);
+        (void)LayeredMap_BakeCollRects(&next);
+        (void)LayeredMap_BuildRegions(&next);
+        (void)LayeredMap_BuildAutotile(&next);
+        LayeredMap_Shutdown(g->map);
+        *g->map = next;
+        memset(&next, 0, sizeof(next));
+        ChunkCache_Clear(g->chunks);
+    }
+    LayeredMap_Shutdown(&next);
+
+    const double ms = (double)(SDL_GetTicksNS() - t0) / 1e6;
+    if (changed < 0)
+        SDL_Log("Hot reload %s: map replaced in %.3f ms", g->current_map, ms);
+    else
+        SDL_Log("Hot reload %s: %d tiles changed in %.3f ms", g->current_map, changed, ms);
 }
 
 // ------------------------------------------------------------
@@ -257,6 +613,27 @@ bool Game_Init(Game* g)
         if (!g->map) return false;
     }
 
+    // Tile properties first: every map parse below reads them
+    TileProps_SetDefaults(&g_tile_props);
+    (void)TileProps_LoadFile(&g_tile_props, TILE_PROPS_DEFAULT_PATH);
+    TileProps_SetActive(&g_tile_props);
+
+    if (!g->map_cache)
+        g->map_cache = MapCache_Create(MAP_CACHE_DEFAULT_BUDGET);
+
+    // Optional: hot reload of saved map edits
+    if (!g->watch)
+        g->watch = MapWatch_Create();
+
+    // Optional: without the worker, doors load synchronously
+    if (!g->preload)
+        g->preload = MapPreload_Create();
+    g->door_pending = false;
+
+    // Optional: without it the static layers are drawn tile by tile
+    if (!g->chunks)
+        g->chunks = ChunkCache_Create();
+
     // Default first map
     if (g->current_map[0] == '\0')
         SDL_strlcpy(g->current_map, "assets/maps/test.map3", sizeof(g->current_map));
@@ -268,23 +645,44 @@ bool Game_Init(Game* g)
     // Load map + spawn player/entities
     // Well fix spawn to tile_size inside the load function by just using ts*4
     // so pass 0/0 and let it compute after load:
-    if (!LayeredMap_LoadFromFile(g->map, g->current_map))
+    // Entered directly: going through the map cache would count a hit for a
+    // map it never held.
+    char first_map[sizeof(g->current_map)];
+    SDL_strlcpy(first_map, g->current_map, sizeof(first_map));
+
+    LayeredMap first;
+    memset(&first, 0, sizeof(first));
+    if (!Game_LoadMap(first_map, &first))
     {
-        SDL_Log("Game_Init: LayeredMap_LoadFromFile failed: %s", g->current_map);
+        SDL_Log("Game_Init: LayeredMap_LoadFromFile failed: %s", first_map);
         return false;
     }
 
     // Now call respawn using proper tile size spawn
-    const float ts = (float)g->map->tile_size;
-    return Game_LoadMapAndRespawn(g, g->current_map, ts * 4.0f, ts * 4.0f);
+    const float ts = (float)first.tile_size;
+    Game_EnterMap(g, &first, first_map, ts * 4.0f, ts * 4.0f);
+    return true;
 }
 
 void Game_Shutdown(Game* g)
 {
     if (!g) return;
 
+    ChunkCache_Destroy(g->chunks);
+    g->chunks = NULL;
     Tiles_Unload();
 
+    MapPreload_Destroy(g->preload);
+    g->preload = NULL;
+    g->door_pending = false;
+
+    MapCache_Destroy(g->map_cache);
+    g->map_cache = NULL;
+
+    MapWatch_Destroy(g->watch);
+    g->watch = NULL;
+    TileProps_SetActive(NULL);
+
     if (g->map)
     {
         LayeredMap_Shutdown(g->map);
@@ -310,15 +708,42 @@ void Game_FixedUpdate(Game* g, PlatformApp* app, double dt)
         g->player_y = p->y;
     }
 
+    Stream_Map(g, app);
+    Map_HotReload(g);
+
+    // Collision edits left the merged rects stale
+    if (LayeredMap_CollRectsStale(g->map)) (void)LayeredMap_BakeCollRects(g->map);
+
+    Door_PreloadNearby(g);
+    if (g->door_pending)
+    {
+        // Door used before its map finished loading: hold until it is ready
+        Door_FinishTransition(g);
+        g->player_vx = g->player_vy = 0.0f;
+        return;
+    }
+
     // Tile-based interaction (keeps your Press E prompt logic)
-    Interaction_Update(&g->interact, app, g->map, g->player_x, g->player_y);
+    const bool dialog_was_open = Interaction_IsDialogOpen(&g->interact);
+    Interaction_Update(&g->interact, app, g->map, g->player_x, g->player_y, (float)dt);
 
-    // E-to-use door (entity-based)
-    if (Input_Pressed(&app->input, SDL_SCANCODE_E))
+    // E-to-use door (entity-based); a press that turned, closed or opened the
+    // dialog is used up
+    if (Input_Pressed(&app->input, SDL_SCANCODE_E) &&
+        !dialog_was_open && !Interaction_IsDialogOpen(&g->interact))
         Door_TryUseNearest(g, app);
 
+    const float prev_x = g->player_x;
+    const float prev_y = g->player_y;
+
     if (!Interaction_IsDialogOpen(&g->interact))
         Move_Player_Entity(g, app, dt);
+
+    if (dt > 0.0)
+    {
+        g->player_vx = (g->player_x - prev_x) / (float)dt;
+        g->player_vy = (g->player_y - prev_y) / (float)dt;
+    }
 }
 
 void Game_Render(Game* g, PlatformApp* app)
@@ -329,12 +754,28 @@ void Game_Render(Game* g, PlatformApp* app)
     const LayeredMap* m = g->map;
     const int ts = m->tile_size;
 
+    // A lost device takes every texture with it; lost targets only their contents
+    if (g->device_resets != app->device_resets)
+    {
+        g->device_resets = app->device_resets;
+        Tiles_Unload();
+        UIText_ReleaseTextures();
+        ChunkCache_Destroy(g->chunks);
+        g->chunks = ChunkCache_Create();
+    }
+    if (g->target_resets != app->target_resets)
+    {
+        g->target_resets = app->target_resets;
+        ChunkCache_Clear(g->chunks);
+    }
+
     // Clear every frame (prevents stuck debug artifacts)
     SDL_SetRenderDrawColor(r, 0, 0, 0, 255);
     SDL_RenderClear(r);
 
-    if (!g_tiles_tex)
+    if (g_atlas.page_count == 0 || g_atlas_ts != ts)
         (void)Tiles_Load(r, "assets/tiles/tileset.png", ts);
+    const TileProps* props = &g_tile_props;
 
     // Focus player
     Entity* pEnt = EntitySystem_FindById(&g->ents, g->player_eid);
@@ -360,74 +801,42 @@ void Game_Render(Game* g, PlatformApp* app)
     int ty1 = (int)ceilf((cam_y + (float)app->win_h) / (float)ts) + 1;
 
     // Clamp to map bounds (no phantom tiles)
-    if (tx0 < 0) tx0 = 0;
-    if (ty0 < 0) ty0 = 0;
-    if (tx1 > m->width)  tx1 = m->width;
-    if (ty1 > m->height) ty1 = m->height;
+    (void)LayeredMap_ClipRect(m, &tx0, &ty0, &tx1, &ty1);
 
-    // Ground
-    for (int ty = ty0; ty < ty1; ++ty)
-    {
-        for (int tx = tx0; tx < tx1; ++tx)
-        {
-            const int gid = LayeredMap_Ground(m, tx, ty);
-            const float dx = (float)(tx * ts) - cam_x + off_x;
-            const float dy = (float)(ty * ts) - cam_y + off_y;
-            Draw_Tile(r, gid, ts, dx, dy);
-        }
-    }
+    TilePass pass = { r, ts, cam_x, cam_y, off_x, off_y, NULL };
 
-    // Deco
-    for (int ty = ty0; ty < ty1; ++ty)
-    {
-        for (int tx = tx0; tx < tx1; ++tx)
-        {
-            const int did = LayeredMap_Deco(m, tx, ty);
-            const float dx = (float)(tx * ts) - cam_x + off_x;
-            const float dy = (float)(ty * ts) - cam_y + off_y;
-            Draw_Tile(r, did, ts, dx, dy);
-        }
-    }
-
-    // Coll placeholder (coll is 0/1 only, so give it a visible wall)
-    for (int ty = ty0; ty < ty1; ++ty)
-    {
-        for (int tx = tx0; tx < tx1; ++tx)
-        {
-            if (!LayeredMap_Solid(m, tx, ty)) continue;
-            if (LayeredMap_Deco(m, tx, ty) != 0) continue;
-
-            const float dx = (float)(tx * ts) - cam_x + off_x;
-            const float dy = (float)(ty * ts) - cam_y + off_y;
-
-            SDL_FRect rc = { dx, dy, (float)ts, (float)ts };
-            SDL_SetRenderDrawColor(r, 70, 70, 90, 255);
-            SDL_RenderFillRect(r, &rc);
-        }
-    }
+    // Static layers: cached chunk textures. Streamed maps draw directly, their
+    // chunks come and go without marking anything dirty.
+    StaticPass sp = { m, props };
+    if (g->chunks && !m->stream)
+        ChunkCache_Draw(g->chunks, r, g->map, tx0, ty0, tx1, ty1, cam_x - off_x, cam_y - off_y, Draw_StaticLayers, &sp);
+    else
+        Draw_StaticLayers(&sp, r, tx0, ty0, tx1, ty1, cam_x - off_x, cam_y - off_y);
 
     // Debug collision overlay
     if (g->debug_collision)
     {
         SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
-        for (int ty = ty0; ty < ty1; ++ty)
+        const SDL_Color overlay = { 255, 0, 0, 70 };
+        const CollRects* rects = LayeredMap_CollRects(m);
+        if (rects)
         {
-            for (int tx = tx0; tx < tx1; ++tx)
-            {
-                if (!LayeredMap_Solid(m, tx, ty)) continue;
-
-                const float dx = (float)(tx * ts) - cam_x + off_x;
-                const float dy = (float)(ty * ts) - cam_y + off_y;
-
-                SDL_FRect rc = { dx, dy, (float)ts, (float)ts };
-                SDL_SetRenderDrawColor(r, 255, 0, 0, 70);
-                SDL_RenderFillRect(r, &rc);
-            }
+            RectBatch_Begin(&g_rect_batch, r, RECT_BATCH_FILL | RECT_BATCH_OUTLINE, overlay);
+            CollRects_Visit(rects, tx0, ty0, tx1, ty1, Fill_CollRect, &pass);
         }
+        else
+        {
+            RectBatch_Begin(&g_rect_batch, r, RECT_BATCH_FILL, overlay);
+            LayeredMap_VisitRect(m, MAP_LAYER_COLL, tx0, ty0, tx1, ty1, Fill_TileRow, &pass);
+        }
+        RectBatch_Flush(&g_rect_batch);
         SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
     }
 
-    // Entities (Y-sort)
+    // Entities (Y-sort); debug feet boxes are outlined on top, all at once
+    const SDL_Color feet_color = { 0, 255, 0, 160 };
+    RectBatch_Begin(&g_rect_batch, r, RECT_BATCH_OUTLINE, feet_color);
+
     int ids[ENTITY_MAX];
     const int n = EntitySystem_BuildRenderListY(&g->ents, ids, ENTITY_MAX);
 
@@ -440,26 +849,45 @@ void Game_Render(Game* g, PlatformApp* app)
         vr.x = vr.x - cam_x + off_x;
         vr.y = vr.y - cam_y + off_y;
 
-        if (e->type == ENT_PLAYER) SDL_SetRenderDrawColor(r, 255, 255, 255, 255);
-        else if (e->type == ENT_NPC) SDL_SetRenderDrawColor(r, 255, 200, 0, 255);
-        else if (e->type == ENT_DOOR) SDL_SetRenderDrawColor(r, 80, 160, 255, 255);
-        else SDL_SetRenderDrawColor(r, 200, 200, 200, 255);
+        // Player: standing frame of the facing row, same atlas page as the tiles
+        const AtlasEntry* sprite = (e->type == ENT_PLAYER && g_player_frames)
+            ? Atlas_Get(&g_atlas, g_player_frames + (int)g->facing * PLAYER_SHEET_COLS + 1)
+            : NULL;
+        if (sprite)
+        {
+            SDL_RenderTexture(r, g_atlas.pages[sprite->page], &sprite->src, &vr);
+        }
+        else
+        {
+            if (e->type == ENT_PLAYER) SDL_SetRenderDrawColor(r, 255, 255, 255, 255);
+            else if (e->type == ENT_NPC) SDL_SetRenderDrawColor(r, 255, 200, 0, 255);
+            else if (e->type == ENT_DOOR) SDL_SetRenderDrawColor(r, 80, 160, 255, 255);
+            else SDL_SetRenderDrawColor(r, 200, 200, 200, 255);
 
-        SDL_RenderFillRect(r, &vr);
+            SDL_RenderFillRect(r, &vr);
+        }
 
         if (g->debug_collision)
         {
-            SDL_FRect feet = Entity_FeetHitbox(e, ts);
-            feet.x = feet.x - cam_x + off_x;
-            feet.y = feet.y - cam_y + off_y;
-
-            SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
-            SDL_SetRenderDrawColor(r, 0, 255, 0, 160);
-            SDL_RenderRect(r, &feet);
-            SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+            const SDL_FRect feet = Entity_FeetHitbox(e, ts);
+            RectBatch_Add(&g_rect_batch, feet.x - cam_x + off_x, feet.y - cam_y + off_y, feet.w, feet.h);
         }
     }
 
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+    RectBatch_Flush(&g_rect_batch);
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+
+    // Dim while a door transition waits for its map
+    if (g->door_pending)
+    {
+        SDL_FRect full = { 0.0f, 0.0f, (float)app->win_w, (float)app->win_h };
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(r, 0, 0, 0, 140);
+        SDL_RenderFillRect(r, &full);
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+    }
+
     // HUD
     Interaction_RenderHUD(&g->interact, r, app->win_w, app->win_h);
 }
@@ -4,6 +4,10 @@
 
 typedef struct PlatformApp PlatformApp;
 typedef struct LayeredMap LayeredMap;
+typedef struct MapPreload MapPreload;
+typedef struct MapCache MapCache;
+typedef struct MapWatch MapWatch;
+typedef struct ChunkCache ChunkCache;
 
 #include "game/entity_system.h"
 #include "game/interaction.h"
@@ -23,12 +27,36 @@ typedef struct Game
     // Track current map path (for door toggles)
     char current_map[128];
 
+    // Maps left through a door stay resident here (NULL = always reload)
+    MapCache* map_cache;
+
+    // Saved edits to the live map are applied in place (NULL = off)
+    MapWatch* watch;
+
+    // Door targets are loaded in the background (NULL = load synchronously).
+    // While a used door's map is still loading the player is held in place.
+    MapPreload* preload;
+    bool  door_pending;
+    char  door_pending_map[128];
+    float door_pending_x;
+    float door_pending_y;
+
+    // Static layers pre-rendered per chunk (NULL = draw tile by tile), and
+    // the renderer resets it has caught up with
+    ChunkCache* chunks;
+    unsigned device_resets;
+    unsigned target_resets;
+
     // Player (legacy fields kept for camera/interaction/UI)
     float player_x;
     float player_y;
     float player_speed;
     PlayerFacing facing;
 
+    // Player velocity (world px/s), drives map streaming look-ahead
+    float player_vx;
+    float player_vy;
+
     bool debug_collision;
 
     InteractionSystem interact;
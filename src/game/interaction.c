@@ -59,16 +59,21 @@ static bool find_nearby_interact(const LayeredMap* map, int ptx, int pty,
 void Interaction_Update(InteractionSystem* is,
                         const PlatformApp* app,
                         const LayeredMap* map,
-                        float player_x, float player_y)
+                        float player_x, float player_y,
+                        float dt)
 {
     if (!is || !app || !map) return;
 
     const PlatformInput* in = &app->input;
 
-    // If dialog open: close with E or Esc
+    // If dialog open: E reveals / turns the page, closes after the last; Esc closes
     if (is->dialog_open)
     {
-        if (Input_Pressed(in, SDL_SCANCODE_E) || Input_Pressed(in, SDL_SCANCODE_ESCAPE))
+        MessageBox_Update(&g_box, dt);
+
+        const bool close = Input_Pressed(in, SDL_SCANCODE_ESCAPE) ||
+                           (Input_Pressed(in, SDL_SCANCODE_E) && !MessageBox_Advance(&g_box));
+        if (close)
         {
             is->dialog_open = false;
             MessageBox_Close(&g_box);
@@ -97,7 +102,7 @@ void Interaction_Update(InteractionSystem* is,
         strncpy(is->dialog_text, t, sizeof(is->dialog_text) - 1);
         is->dialog_text[sizeof(is->dialog_text) - 1] = '\0';
 
-        MessageBox_Open(&g_box, is->dialog_text);
+        MessageBox_Open(&g_box, is->dialog_text, app->win_w);
 
         SDL_Log("INTERACT id=%d at (%d,%d): %s", id, tx, ty, is->dialog_text);
     }
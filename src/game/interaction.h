@@ -19,11 +19,13 @@ typedef struct InteractionSystem
 void Interaction_Init(InteractionSystem* is);
 bool Interaction_IsDialogOpen(const InteractionSystem* is);
 
-// Update: finds nearby interactables and opens/closes dialog with E/Esc.
+// Update: finds nearby interactables and opens/closes dialog with E/Esc;
+// while it is open, E pages through it and dt drives the text reveal.
 void Interaction_Update(InteractionSystem* is,
                         const PlatformApp* app,
                         const LayeredMap* map,
-                        float player_x, float player_y);
+                        float player_x, float player_y,
+                        float dt);
 
 // Render UI overlay (prompt + message box) in screen-space.
 void Interaction_RenderHUD(InteractionSystem* is,
@@ -134,6 +134,14 @@ void PlatformApp_PumpEvents(PlatformApp* app)
                 SDL_GetWindowSize(app->window, &app->win_w, &app->win_h);
                 break;
 
+            case SDL_EVENT_RENDER_DEVICE_RESET:
+                app->device_resets++;
+                break;
+
+            case SDL_EVENT_RENDER_TARGETS_RESET:
+                app->target_resets++;
+                break;
+
             default:
                 break;
         }
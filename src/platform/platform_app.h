@@ -18,6 +18,11 @@ typedef struct PlatformApp
     int win_w;
     int win_h;
 
+    // Bumped when the renderer loses all textures (device reset) or the
+    // contents of its render targets (targets reset)
+    unsigned device_resets;
+    unsigned target_resets;
+
     PlatformInput input;
 } PlatformApp;
 
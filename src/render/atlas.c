@@ -0,0 +1,206 @@
+// src/render/atlas.c
+#include "atlas.h"
+
+#include <SDL3_image/SDL_image.h>
+#include <string.h>
+
+int Atlas_AddSurface(Atlas* a, const char* name, SDL_Surface* s, int cell_w, int cell_h)
+{
+    if (!a || !s || !name || cell_w <= 0 || cell_h <= 0)
+    {
+        if (s) SDL_DestroySurface(s);
+        return 0;
+    }
+    if (a->page_count > 0 || a->sheet_count == ATLAS_MAX_SHEETS)
+    {
+        SDL_Log("Atlas: cannot add '%s' (%s)", name, a->page_count ? "already built" : "too many sheets");
+        SDL_DestroySurface(s);
+        return 0;
+    }
+
+    const int cols = s->w / cell_w, rows = s->h / cell_h;
+    if (cols <= 0 || rows <= 0)
+    {
+        SDL_Log("Atlas: '%s' (%dx%d) is smaller than one %dx%d cell", name, s->w, s->h, cell_w, cell_h);
+        SDL_DestroySurface(s);
+        return 0;
+    }
+
+    AtlasSheet* sh = &a->sheets[a->sheet_count++];
+    memset(sh, 0, sizeof(*sh));
+    SDL_strlcpy(sh->name, name, sizeof(sh->name));
+    sh->first_id = a->count + 1;
+    sh->cols = cols;
+    sh->rows = rows;
+    sh->cell_w = cell_w;
+    sh->cell_h = cell_h;
+    sh->pixels = s;
+
+    a->count += cols * rows;
+    return sh->first_id;
+}
+
+int Atlas_AddImage(Atlas* a, const char* name, const char* path, int cell_w, int cell_h)
+{
+    if (!path) return 0;
+
+    SDL_Surface* s = IMG_Load(path);
+    if (!s)
+    {
+        SDL_Log("Atlas: IMG_Load failed: %s (%s)", path, SDL_GetError());
+        return 0;
+    }
+    return Atlas_AddSurface(a, name, s, cell_w, cell_h);
+}
+
+// Shelf-pack the sheets, tallest first. Returns the page count, 0 if a sheet
+// does not fit.
+static int pack(Atlas* a, int limit, int page_w[ATLAS_MAX_PAGES], int page_h[ATLAS_MAX_PAGES])
+{
+    int order[ATLAS_MAX_SHEETS];
+    for (int i = 0; i < a->sheet_count; ++i)
+    {
+        int j = i;
+        const int h = a->sheets[i].rows * a->sheets[i].cell_h;
+        for (; j > 0 && a->sheets[order[j - 1]].rows * a->sheets[order[j - 1]].cell_h < h; --j)
+            order[j] = order[j - 1];
+        order[j] = i;
+    }
+
+    int pages = 0, x = 0, shelf_y = 0, shelf_h = 0;
+    for (int k = 0; k < a->sheet_count; ++k)
+    {
+        AtlasSheet* sh = &a->sheets[order[k]];
+        const int w = sh->cols * sh->cell_w, h = sh->rows * sh->cell_h;
+        if (w > limit || h > limit)
+        {
+            SDL_Log("Atlas: '%s' (%dx%d) exceeds the %d px page limit", sh->name, w, h, limit);
+            return 0;
+        }
+
+        if (pages > 0 && x + w > limit)
+        {
+            x = 0;
+            shelf_y += shelf_h + ATLAS_PADDING;
+            shelf_h = 0;
+        }
+        if (pages == 0 || shelf_y + h > limit)
+        {
+            if (pages == ATLAS_MAX_PAGES)
+            {
+                SDL_Log("Atlas: sheets do not fit in %d pages of %d px", ATLAS_MAX_PAGES, limit);
+                return 0;
+            }
+            page_w[pages] = page_h[pages] = 0;
+            pages++;
+            x = shelf_y = shelf_h = 0;
+        }
+
+        sh->page = pages - 1;
+        sh->x = x;
+        sh->y = shelf_y;
+        x += w + ATLAS_PADDING;
+        shelf_h = SDL_max(shelf_h, h);
+        page_w[sh->page] = SDL_max(page_w[sh->page], sh->x + w);
+        page_h[sh->page] = SDL_max(page_h[sh->page], sh->y + h);
+    }
+    return pages;
+}
+
+static SDL_Texture* upload_page(const Atlas* a, SDL_Renderer* r, int page, int w, int h)
+{
+    SDL_Surface* dst = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_RGBA32);
+    if (!dst) return NULL;
+    SDL_FillSurfaceRect(dst, NULL, 0);
+
+    for (int i = 0; i < a->sheet_count; ++i)
+    {
+        const AtlasSheet* sh = &a->sheets[i];
+        if (sh->page != page) continue;
+
+        SDL_Rect src = { 0, 0, sh->cols * sh->cell_w, sh->rows * sh->cell_h };
+        SDL_Rect at = { sh->x, sh->y, src.w, src.h };
+        SDL_SetSurfaceBlendMode(sh->pixels, SDL_BLENDMODE_NONE);   // copy alpha as is
+        SDL_BlitSurface(sh->pixels, &src, dst, &at);
+    }
+
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(r, dst);
+    SDL_DestroySurface(dst);
+    if (tex) SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_BLEND);
+    return tex;
+}
+
+bool Atlas_Build(Atlas* a, SDL_Renderer* r)
+{
+    if (!a || !r || a->sheet_count == 0 || a->page_count > 0) return false;
+
+    int limit = ATLAS_PAGE_MAX;
+    const Sint64 max_tex = SDL_GetNumberProperty(SDL_GetRendererProperties(r), SDL_PROP_RENDERER_MAX_TEXTURE_SIZE_NUMBER, 0);
+    if (max_tex > 0 && max_tex < limit) limit = (int)max_tex;
+
+    int page_w[ATLAS_MAX_PAGES], page_h[ATLAS_MAX_PAGES];
+    const int pages = pack(a, limit, page_w, page_h);
+
+    a->entries = pages ? (AtlasEntry*)SDL_calloc((size_t)a->count, sizeof(AtlasEntry)) : NULL;
+    if (!a->entries) goto fail;
+
+    for (int p = 0; p < pages; ++p)
+    {
+        a->pages[p] = upload_page(a, r, p, page_w[p], page_h[p]);
+        if (!a->pages[p])
+        {
+            SDL_Log("Atlas: page %d upload failed: %s", p, SDL_GetError());
+            goto fail;
+        }
+        a->page_count++;
+    }
+
+    for (int i = 0; i < a->sheet_count; ++i)
+    {
+        AtlasSheet* sh = &a->sheets[i];
+        const float inv_w = 1.0f / (float)page_w[sh->page], inv_h = 1.0f / (float)page_h[sh->page];
+
+        for (int k = 0; k < sh->cols * sh->rows; ++k)
+        {
+            AtlasEntry* e = &a->entries[sh->first_id - 1 + k];
+            e->src.x = (float)(sh->x + (k % sh->cols) * sh->cell_w);
+            e->src.y = (float)(sh->y + (k / sh->cols) * sh->cell_h);
+            e->src.w = (float)sh->cell_w;
+            e->src.h = (float)sh->cell_h;
+            e->u0 = e->src.x * inv_w;
+            e->v0 = e->src.y * inv_h;
+            e->u1 = (e->src.x + e->src.w) * inv_w;
+            e->v1 = (e->src.y + e->src.h) * inv_h;
+            e->page = sh->page;
+        }
+
+        SDL_DestroySurface(sh->pixels);
+        sh->pixels = NULL;
+    }
+
+    SDL_Log("Atlas: %d sheets, %d ids in %d page(s)", a->sheet_count, a->count, a->page_count);
+    return true;
+
+fail:
+    Atlas_Destroy(a);
+    return false;
+}
+
+void Atlas_Destroy(Atlas* a)
+{
+    if (!a) return;
+
+    for (int p = 0; p < a->page_count; ++p) SDL_DestroyTexture(a->pages[p]);
+    for (int i = 0; i < a->sheet_count; ++i)
+        if (a->sheets[i].pixels) SDL_DestroySurface(a->sheets[i].pixels);
+    SDL_free(a->entries);
+    memset(a, 0, sizeof(*a));
+}
+
+int Atlas_FirstId(const Atlas* a, const char* name)
+{
+    if (!a || !name) return 0;
+    for (int i = 0; i < a->sheet_count; ++i)
+        if (SDL_strcmp(a->sheets[i].name, name) == 0) return a->sheets[i].first_id;
+    return 0;
+}
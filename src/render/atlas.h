@@ -0,0 +1,72 @@
+// src/render/atlas.h
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL3/SDL.h>
+
+// Texture atlas for tilesets and sprite sheets
+//
+// Sheets are added as images cut into a grid of cells; every cell gets a
+// global id, assigned in the order sheets are added and starting at 1
+// (0 = empty), so the first sheet's ids match its row-major tile ids.
+// Atlas_Build packs the sheets (shelf packing, tallest first) into as few
+// page textures as the renderer's size limit allows and fills a table with
+// each id's page, source rect and texture coordinates; drawing a cell is a
+// table load, with no per-tile division. Main thread only.
+
+#define ATLAS_MAX_SHEETS 16
+#define ATLAS_MAX_PAGES  4
+#define ATLAS_PAGE_MAX   4096   // page side limit (lower if the renderer's is)
+#define ATLAS_PADDING    1      // transparent pixels between sheets
+#define ATLAS_NAME_MAX   32
+
+typedef struct AtlasEntry
+{
+    SDL_FRect src;            // pixels in the page
+    float u0, v0, u1, v1;     // texture coordinates
+    int page;
+} AtlasEntry;
+
+typedef struct AtlasSheet
+{
+    char name[ATLAS_NAME_MAX];
+    int first_id;
+    int cols, rows;
+    int cell_w, cell_h;
+    SDL_Surface* pixels;      // until Atlas_Build
+    int page, x, y;           // placement
+} AtlasSheet;
+
+typedef struct Atlas
+{
+    AtlasSheet sheets[ATLAS_MAX_SHEETS];
+    int sheet_count;
+
+    SDL_Texture* pages[ATLAS_MAX_PAGES];
+    int page_count;
+
+    AtlasEntry* entries;      // id - 1
+    int count;                // ids handed out
+} Atlas;
+
+// Add a sheet; the atlas takes ownership of "s" (freed even on failure).
+// Returns the sheet's first id, 0 on failure.
+int Atlas_AddSurface(Atlas* a, const char* name, SDL_Surface* s, int cell_w, int cell_h);
+
+// Same, loading the image from disk.
+int Atlas_AddImage(Atlas* a, const char* name, const char* path, int cell_w, int cell_h);
+
+// Pack the added sheets into page textures and fill the id table. On failure
+// the atlas is left empty (Atlas_Destroy'd).
+bool Atlas_Build(Atlas* a, SDL_Renderer* r);
+
+// Free textures, table and sheets; the atlas can be filled again.
+void Atlas_Destroy(Atlas* a);
+
+// First id of the sheet called "name", 0 if there is none.
+int Atlas_FirstId(const Atlas* a, const char* name);
+
+static inline const AtlasEntry* Atlas_Get(const Atlas* a, int id)
+{
+    return (id > 0 && id <= a->count && a->entries) ? &a->entries[id - 1] : NULL;
+}
@@ -0,0 +1,207 @@
+// src/render/chunk_cache.c
+#include "chunk_cache.h"
+#include "world/layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+typedef struct ChunkSlot
+{
+    SDL_Texture* tex;
+    int cx, cy;
+    bool valid;     // tex holds chunk (cx, cy)
+    Uint64 used;    // frame it was last blitted
+} ChunkSlot;
+
+struct ChunkCache
+{
+    SDL_Renderer* renderer;   // owner of the textures
+    int tile_size;
+    bool no_targets;          // render targets failed: draw everything directly
+    Uint64 frame;
+
+    ChunkSlot slots[CHUNK_CACHE_SLOTS];
+    ChunkCacheStats stats;
+};
+
+static void release_textures(ChunkCache* c)
+{
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+    {
+        if (c->slots[i].tex) SDL_DestroyTexture(c->slots[i].tex);
+        c->slots[i].tex = NULL;
+        c->slots[i].valid = false;
+    }
+    c->stats.textures = 0;
+}
+
+ChunkCache* ChunkCache_Create(void)
+{
+    return (ChunkCache*)SDL_calloc(1, sizeof(ChunkCache));
+}
+
+void ChunkCache_Destroy(ChunkCache* c)
+{
+    if (!c) return;
+    release_textures(c);
+    SDL_free(c);
+}
+
+void ChunkCache_Clear(ChunkCache* c)
+{
+    if (!c) return;
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i) c->slots[i].valid = false;
+}
+
+static void invalidate(ChunkCache* c, int cx, int cy)
+{
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+    {
+        ChunkSlot* s = &c->slots[i];
+        if (s->valid && s->cx == cx && s->cy == cy) s->valid = false;
+    }
+}
+
+static ChunkSlot* find(ChunkCache* c, int cx, int cy)
+{
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+    {
+        ChunkSlot* s = &c->slots[i];
+        if (s->valid && s->cx == cx && s->cy == cy) return s;
+    }
+    return NULL;
+}
+
+// A slot for a new chunk: an unused texture, then room for a new one, then
+// the least recently used chunk not already drawn this frame.
+static ChunkSlot* acquire(ChunkCache* c)
+{
+    ChunkSlot* empty = NULL;
+    ChunkSlot* oldest = NULL;
+    for (int i = 0; i < CHUNK_CACHE_SLOTS; ++i)
+    {
+        ChunkSlot* s = &c->slots[i];
+        if (s->tex && !s->valid) return s;
+        if (!s->tex) { if (!empty) empty = s; continue; }
+        if (s->used != c->frame && (!oldest || s->used < oldest->used)) oldest = s;
+    }
+    return empty ? empty : oldest;
+}
+
+// Render chunk (cx, cy) into slot s. False if render targets do not work.
+static bool render_chunk(ChunkCache* c, ChunkSlot* s, SDL_Renderer* r, const LayeredMap* m,
+                         int cx, int cy, ChunkCacheDrawFn draw, void* user)
+{
+    const int px = LAYERED_MAP_CHUNK * c->tile_size;
+    if (!s->tex)
+    {
+        s->tex = SDL_CreateTexture(r, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, px, px);
+        if (!s->tex)
+        {
+            SDL_Log("ChunkCache: render targets unavailable, drawing tiles directly (%s)", SDL_GetError());
+            return false;
+        }
+        // Nearest sampling: chunks meet at fractional camera offsets without seams
+        SDL_SetTextureBlendMode(s->tex, SDL_BLENDMODE_BLEND);
+        SDL_SetTextureScaleMode(s->tex, SDL_SCALEMODE_NEAREST);
+        c->stats.textures++;
+    }
+
+    SDL_Texture* prev = SDL_GetRenderTarget(r);
+    if (!SDL_SetRenderTarget(r, s->tex))
+    {
+        SDL_Log("ChunkCache: SDL_SetRenderTarget failed: %s", SDL_GetError());
+        return false;
+    }
+
+    SDL_SetRenderDrawColor(r, 0, 0, 0, 0);
+    SDL_RenderClear(r);
+
+    const int x0 = cx * LAYERED_MAP_CHUNK, y0 = cy * LAYERED_MAP_CHUNK;
+    const int x1 = SDL_min(x0 + LAYERED_MAP_CHUNK, m->width);
+    const int y1 = SDL_min(y0 + LAYERED_MAP_CHUNK, m->height);
+    draw(user, r, x0, y0, x1, y1, (float)(x0 * c->tile_size), (float)(y0 * c->tile_size));
+
+    SDL_SetRenderTarget(r, prev);
+
+    s->cx = cx;
+    s->cy = cy;
+    s->valid = true;
+    c->stats.rebuilt++;
+    return true;
+}
+
+void ChunkCache_Draw(ChunkCache* c, SDL_Renderer* r, LayeredMap* m,
+                     int tx0, int ty0, int tx1, int ty1,
+                     float org_x, float org_y,
+                     ChunkCacheDrawFn draw, void* user)
+{
+    if (!c || !r || !m || !draw) return;
+
+    c->frame++;
+    c->stats.blits = c->stats.rebuilt = c->stats.direct = 0;
+
+    // Textures are sized for one renderer and tile size
+    if (c->renderer != r || c->tile_size != m->tile_size)
+    {
+        release_textures(c);
+        c->renderer = r;
+        c->tile_size = m->tile_size;
+        c->no_targets = false;
+    }
+
+    int dcx, dcy;
+    while (LayeredMap_TakeDirtyChunk(m, &dcx, &dcy)) invalidate(c, dcx, dcy);
+
+    if (tx1 <= tx0 || ty1 <= ty0) return;
+
+    const int ts = c->tile_size;
+    const int cx0 = tx0 >> LAYERED_MAP_CHUNK_SHIFT, cx1 = (tx1 - 1) >> LAYERED_MAP_CHUNK_SHIFT;
+    const int cy0 = ty0 >> LAYERED_MAP_CHUNK_SHIFT, cy1 = (ty1 - 1) >> LAYERED_MAP_CHUNK_SHIFT;
+
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+            const int x0 = cx * LAYERED_MAP_CHUNK, y0 = cy * LAYERED_MAP_CHUNK;
+
+            ChunkSlot* s = c->no_targets ? NULL : find(c, cx, cy);
+            if (!s && !c->no_targets)
+            {
+                s = acquire(c);
+                if (s && !render_chunk(c, s, r, m, cx, cy, draw, user))
+                {
+                    c->no_targets = true;
+                    release_textures(c);
+                    s = NULL;
+                }
+            }
+
+            if (!s)
+            {
+                draw(user, r,
+                     SDL_max(x0, tx0), SDL_max(y0, ty0),
+                     SDL_min(x0 + LAYERED_MAP_CHUNK, tx1), SDL_min(y0 + LAYERED_MAP_CHUNK, ty1),
+                     org_x, org_y);
+                c->stats.direct++;
+                continue;
+            }
+
+            const float w = (float)((SDL_min(x0 + LAYERED_MAP_CHUNK, m->width) - x0) * ts);
+            const float h = (float)((SDL_min(y0 + LAYERED_MAP_CHUNK, m->height) - y0) * ts);
+            SDL_FRect src = { 0.0f, 0.0f, w, h };
+            SDL_FRect dst = { (float)(x0 * ts) - org_x, (float)(y0 * ts) - org_y, w, h };
+            SDL_RenderTexture(r, s->tex, &src, &dst);
+
+            s->used = c->frame;
+            c->stats.blits++;
+        }
+    }
+}
+
+void ChunkCache_GetStats(const ChunkCache* c, ChunkCacheStats* out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (c) *out = c->stats;
+}
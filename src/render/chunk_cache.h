@@ -0,0 +1,48 @@
+// src/render/chunk_cache.h
+#pragma once
+#include <stdbool.h>
+
+typedef struct SDL_Renderer SDL_Renderer;
+typedef struct LayeredMap LayeredMap;
+typedef struct ChunkCache ChunkCache;
+
+// Pre-rendered static layers
+//
+// The map is cut into LAYERED_MAP_CHUNK-sized chunks; each visible chunk is
+// drawn once into a render-target texture and blitted with one call per
+// frame after that. Chunks are redrawn only when the map reports them dirty
+// (LayeredMap_TakeDirtyChunk: the cache is the owner of those bits). Textures
+// are created lazily and reused least recently used first; a chunk that finds
+// no slot, or a renderer without render targets, is drawn directly.
+
+#define CHUNK_CACHE_SLOTS 32   // 1 MiB each at 32px tiles
+
+// Draws tiles [tx0, tx1) x [ty0, ty1); a tile's world pixel position minus
+// (org_x, org_y) is where it lands on the current target.
+typedef void (*ChunkCacheDrawFn)(void* user, SDL_Renderer* r,
+                                 int tx0, int ty0, int tx1, int ty1,
+                                 float org_x, float org_y);
+
+typedef struct ChunkCacheStats
+{
+    int blits;      // chunk textures drawn last frame
+    int rebuilt;    // chunks re-rendered last frame
+    int direct;     // chunks drawn without a texture last frame
+    int textures;   // textures currently allocated
+} ChunkCacheStats;
+
+ChunkCache* ChunkCache_Create(void);
+void ChunkCache_Destroy(ChunkCache* c);
+
+// Forget every chunk: the map was replaced or the renderer lost its targets.
+void ChunkCache_Clear(ChunkCache* c);
+
+// Draw the static layers of the clipped tile rect [tx0, tx1) x [ty0, ty1)
+// to the screen, where screen = world - (org_x, org_y). Consumes the map's
+// dirty chunks first.
+void ChunkCache_Draw(ChunkCache* c, SDL_Renderer* r, LayeredMap* m,
+                     int tx0, int ty0, int tx1, int ty1,
+                     float org_x, float org_y,
+                     ChunkCacheDrawFn draw, void* user);
+
+void ChunkCache_GetStats(const ChunkCache* c, ChunkCacheStats* out);
@@ -0,0 +1,45 @@
+// src/render/rect_batch.c
+#include "rect_batch.h"
+
+void RectBatch_Begin(RectBatch* b, SDL_Renderer* r, int mode, SDL_Color color)
+{
+    if (!b) return;
+    RectBatch_Flush(b);
+
+    b->r = r;
+    b->mode = mode;
+    b->color = color;
+}
+
+void RectBatch_Add(RectBatch* b, float x, float y, float w, float h)
+{
+    if (!b) return;
+    if (b->count == RECT_BATCH_MAX) RectBatch_Flush(b);
+
+    SDL_FRect* rc = &b->rects[b->count++];
+    rc->x = x;
+    rc->y = y;
+    rc->w = w;
+    rc->h = h;
+}
+
+void RectBatch_Flush(RectBatch* b)
+{
+    if (!b || b->count == 0) return;
+
+    if (b->r)
+    {
+        SDL_SetRenderDrawColor(b->r, b->color.r, b->color.g, b->color.b, b->color.a);
+        if (b->mode & RECT_BATCH_FILL)
+        {
+            SDL_RenderFillRects(b->r, b->rects, b->count);
+            b->draw_calls++;
+        }
+        if (b->mode & RECT_BATCH_OUTLINE)
+        {
+            SDL_RenderRects(b->r, b->rects, b->count);
+            b->draw_calls++;
+        }
+    }
+    b->count = 0;
+}
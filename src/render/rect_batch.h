@@ -0,0 +1,38 @@
+// src/render/rect_batch.h
+#pragma once
+#include <stdbool.h>
+#include <SDL3/SDL.h>
+
+// Rects of one color submitted together
+//
+// Rects are collected into a fixed array and drawn with one
+// SDL_RenderFillRects and/or SDL_RenderRects call per flush; a full array
+// flushes on its own. The renderer's blend mode is left to the caller.
+
+#define RECT_BATCH_MAX 1024
+
+typedef enum RectBatchMode
+{
+    RECT_BATCH_FILL    = 1,
+    RECT_BATCH_OUTLINE = 2
+} RectBatchMode;
+
+typedef struct RectBatch
+{
+    SDL_Renderer* r;
+    int mode;               // RectBatchMode bits
+    SDL_Color color;
+
+    SDL_FRect rects[RECT_BATCH_MAX];
+    int count;
+
+    unsigned draw_calls;    // fill/outline submissions made (caller resets)
+} RectBatch;
+
+// Start collecting rects drawn with "mode" in "color"; flushes the previous set.
+void RectBatch_Begin(RectBatch* b, SDL_Renderer* r, int mode, SDL_Color color);
+
+void RectBatch_Add(RectBatch* b, float x, float y, float w, float h);
+
+// Submit everything collected.
+void RectBatch_Flush(RectBatch* b);
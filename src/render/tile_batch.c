@@ -0,0 +1,105 @@
+// src/render/tile_batch.c
+#include "tile_batch.h"
+#include "atlas.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+void TileBatch_Free(TileBatch* b)
+{
+    if (!b) return;
+    SDL_free(b->verts);
+    SDL_free(b->indices);
+    memset(b, 0, sizeof(*b));
+}
+
+void TileBatch_Begin(TileBatch* b, SDL_Renderer* r, const Atlas* atlas)
+{
+    if (!b) return;
+    if (b->r != r || b->atlas != atlas) TileBatch_Flush(b);
+
+    b->r = r;
+    b->atlas = atlas;
+}
+
+void TileBatch_SetTint(TileBatch* b, SDL_Color c)
+{
+    if (!b) return;
+    b->tinted = (c.r & c.g & c.b & c.a) != 255;
+    b->tint[0] = (float)c.r / 255.0f;
+    b->tint[1] = (float)c.g / 255.0f;
+    b->tint[2] = (float)c.b / 255.0f;
+    b->tint[3] = (float)c.a / 255.0f;
+}
+
+static bool grow(TileBatch* b)
+{
+    if (b->capacity >= TILE_BATCH_MAX_QUADS) return false;
+    const int cap = b->capacity ? SDL_min(b->capacity * 2, TILE_BATCH_MAX_QUADS) : 256;
+
+    SDL_Vertex* verts = (SDL_Vertex*)SDL_realloc(b->verts, sizeof(SDL_Vertex) * 4 * (size_t)cap);
+    if (!verts) return false;
+    b->verts = verts;
+
+    int* indices = (int*)SDL_realloc(b->indices, sizeof(int) * 6 * (size_t)cap);
+    if (!indices) return false;
+    b->indices = indices;
+
+    for (int q = b->capacity; q < cap; ++q)
+    {
+        int* i = indices + q * 6;
+        const int v = q * 4;
+        i[0] = v; i[1] = v + 1; i[2] = v + 2;
+        i[3] = v + 2; i[4] = v + 3; i[5] = v;
+    }
+    b->capacity = cap;
+    return true;
+}
+
+void TileBatch_Add(TileBatch* b, int id, float dx, float dy)
+{
+    if (!b || !b->atlas) return;
+
+    const AtlasEntry* e = Atlas_Get(b->atlas, id);
+    if (!e) return;
+
+    SDL_Texture* page = b->atlas->pages[e->page];
+    if (page != b->page)
+    {
+        TileBatch_Flush(b);
+        b->page = page;
+    }
+
+    if (b->quads == b->capacity && !grow(b))
+    {
+        TileBatch_Flush(b);
+        if (b->capacity == 0) return;   // never got a buffer
+    }
+
+    const float u0 = e->u0, v0 = e->v0, u1 = e->u1, v1 = e->v1;
+    const float x1 = dx + e->src.w, y1 = dy + e->src.h;
+
+    SDL_Vertex* v = b->verts + b->quads * 4;
+    SDL_FColor col = { 1.0f, 1.0f, 1.0f, 1.0f };
+    if (b->tinted)
+    {
+        col.r = b->tint[0]; col.g = b->tint[1]; col.b = b->tint[2]; col.a = b->tint[3];
+    }
+    v[0].position.x = dx; v[0].position.y = dy; v[0].tex_coord.x = u0; v[0].tex_coord.y = v0; v[0].color = col;
+    v[1].position.x = x1; v[1].position.y = dy; v[1].tex_coord.x = u1; v[1].tex_coord.y = v0; v[1].color = col;
+    v[2].position.x = x1; v[2].position.y = y1; v[2].tex_coord.x = u1; v[2].tex_coord.y = v1; v[2].color = col;
+    v[3].position.x = dx; v[3].position.y = y1; v[3].tex_coord.x = u0; v[3].tex_coord.y = v1; v[3].color = col;
+    b->quads++;
+}
+
+void TileBatch_Flush(TileBatch* b)
+{
+    if (!b || b->quads == 0) return;
+
+    if (b->r && b->page)
+    {
+        SDL_RenderGeometry(b->r, b->page, b->verts, b->quads * 4, b->indices, b->quads * 6);
+        b->draw_calls++;
+    }
+    b->quads = 0;
+}
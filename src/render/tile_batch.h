@@ -0,0 +1,55 @@
+// src/render/tile_batch.h
+#pragma once
+#include <stdbool.h>
+
+typedef struct SDL_Renderer SDL_Renderer;
+typedef struct SDL_Texture SDL_Texture;
+typedef struct SDL_Vertex SDL_Vertex;
+typedef struct SDL_Color SDL_Color;
+typedef struct Atlas Atlas;
+
+// Atlas cells submitted with a single SDL_RenderGeometry call
+//
+// Ids are atlas ids (0 = empty). Added cells are queued as quads in a
+// reusable vertex buffer, texture coordinates straight from the atlas table;
+// the index buffer never changes once grown (two triangles per quad). Cells
+// are drawn white unless a tint is set, which goes into the vertex colors so
+// differently tinted cells still share a call. Queued
+// cells go out on Flush, when a cell lives on another atlas page, or when
+// TILE_BATCH_MAX_QUADS are waiting. Main thread only.
+
+#define TILE_BATCH_MAX_QUADS 16384
+
+typedef struct TileBatch
+{
+    SDL_Renderer* r;
+    const Atlas* atlas;
+    SDL_Texture* page;      // page of the queued quads
+
+    SDL_Vertex* verts;      // 4 per quad
+    int* indices;           // 6 per quad
+    int quads;              // queued
+    int capacity;           // quads the buffers hold
+
+    bool tinted;
+    float tint[4];          // rgba 0..1 when tinted
+
+    unsigned draw_calls;    // SDL_RenderGeometry calls made (caller resets)
+} TileBatch;
+
+// Free the buffers (the batch may be reused afterwards).
+void TileBatch_Free(TileBatch* b);
+
+// Start queueing cells of "atlas"; flushes quads queued for another atlas or
+// renderer. A NULL atlas makes Add a no-op.
+void TileBatch_Begin(TileBatch* b, SDL_Renderer* r, const Atlas* atlas);
+
+// Vertex color for cells added from now on; white turns tinting off.
+void TileBatch_SetTint(TileBatch* b, SDL_Color c);
+
+// Queue cell "id" with its top-left at screen position (dx, dy), at the
+// cell's own size.
+void TileBatch_Add(TileBatch* b, int id, float dx, float dy);
+
+// Submit everything queued.
+void TileBatch_Flush(TileBatch* b);
@@ -0,0 +1,168 @@
+#include "ui/glyph_atlas.h"
+
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string.h>
+
+#define GLYPH_SHEET_COLS 16
+
+// Atlas slot of a codepoint, -1 if it has none.
+static int glyph_index(Uint32 cp)
+{
+    if (cp >= 0x20 && cp <= 0x7E) return (int)cp - 0x20;
+    if (cp >= 0xA0 && cp <= 0xFF) return 95 + (int)cp - 0xA0;
+    return -1;
+}
+
+static Uint32 glyph_codepoint(int i)
+{
+    return (i < 95) ? (Uint32)(0x20 + i) : (Uint32)(0xA0 + i - 95);
+}
+
+bool GlyphAtlas_Init(GlyphAtlas* g, TTF_Font* font)
+{
+    if (!g || !font) return false;
+    memset(g, 0, sizeof(*g));
+    g->font = font;
+    g->height = TTF_GetFontHeight(font);
+
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; ++i)
+    {
+        const Uint32 cp = glyph_codepoint(i);
+        int adv = 0;
+        g->has[i] = TTF_FontHasGlyph(font, cp) && TTF_GetGlyphMetrics(font, cp, NULL, NULL, NULL, NULL, &adv);
+        g->advance[i] = adv;
+    }
+
+    for (int a = 0; a < GLYPH_ATLAS_COUNT; ++a)
+    {
+        if (!g->has[a]) continue;
+        for (int b = 0; b < GLYPH_ATLAS_COUNT; ++b)
+        {
+            int k = 0;
+            if (g->has[b] && TTF_GetGlyphKerning(font, glyph_codepoint(a), glyph_codepoint(b), &k))
+                g->kern[a][b] = (int8_t)SDL_clamp(k, -128, 127);
+        }
+    }
+    return true;
+}
+
+void GlyphAtlas_ReleaseTextures(GlyphAtlas* g)
+{
+    if (!g) return;
+    TileBatch_Free(&g->batch);
+    Atlas_Destroy(&g->atlas);
+    g->renderer = NULL;
+    g->build_failed = false;
+}
+
+void GlyphAtlas_Shutdown(GlyphAtlas* g)
+{
+    if (!g) return;
+    GlyphAtlas_ReleaseTextures(g);
+    memset(g, 0, sizeof(*g));
+}
+
+// Rasterize every covered glyph white into a grid sheet (cell id = slot + 1)
+// and upload it; tinting happens in the vertex colors.
+static bool build(GlyphAtlas* g, SDL_Renderer* r)
+{
+    const SDL_Color white = { 255, 255, 255, 255 };
+    SDL_Surface* cells[GLYPH_ATLAS_COUNT] = { 0 };
+    int cell_w = 1;
+
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; ++i)
+    {
+        if (!g->has[i] || i == 0) continue;   // space draws nothing
+        cells[i] = TTF_RenderGlyph_Blended(g->font, glyph_codepoint(i), white);
+        if (cells[i]) cell_w = SDL_max(cell_w, cells[i]->w);
+    }
+
+    const int rows = (GLYPH_ATLAS_COUNT + GLYPH_SHEET_COLS - 1) / GLYPH_SHEET_COLS;
+    SDL_Surface* sheet = SDL_CreateSurface(GLYPH_SHEET_COLS * cell_w, rows * g->height, SDL_PIXELFORMAT_RGBA32);
+    if (sheet) SDL_FillSurfaceRect(sheet, NULL, 0);
+
+    for (int i = 0; i < GLYPH_ATLAS_COUNT; ++i)
+    {
+        if (!cells[i]) continue;
+        if (sheet)
+        {
+            SDL_Rect src = { 0, 0, cells[i]->w, SDL_min(cells[i]->h, g->height) };
+            SDL_Rect at = { (i % GLYPH_SHEET_COLS) * cell_w, (i / GLYPH_SHEET_COLS) * g->height, src.w, src.h };
+            SDL_SetSurfaceBlendMode(cells[i], SDL_BLENDMODE_NONE);
+            SDL_BlitSurface(cells[i], &src, sheet, &at);
+        }
+        SDL_DestroySurface(cells[i]);
+    }
+
+    if (!sheet)
+    {
+        SDL_Log("GlyphAtlas: sheet surface failed: %s", SDL_GetError());
+        return false;
+    }
+
+    if (Atlas_AddSurface(&g->atlas, "glyphs", sheet, cell_w, g->height) != 1 || !Atlas_Build(&g->atlas, r))
+    {
+        SDL_Log("GlyphAtlas: upload failed, using per-string rendering");
+        Atlas_Destroy(&g->atlas);
+        return false;
+    }
+    return true;
+}
+
+bool GlyphAtlas_Measure(const GlyphAtlas* g, const char* text, int* out_w, int* out_h)
+{
+    if (!g || !g->font || !text) return false;
+
+    size_t len = SDL_strlen(text);
+    int w = 0, prev = -1;
+    while (len > 0)
+    {
+        const int i = glyph_index(SDL_StepUTF8(&text, &len));
+        if (i < 0 || !g->has[i]) return false;
+
+        if (prev >= 0) w += g->kern[prev][i];
+        w += g->advance[i];
+        prev = i;
+    }
+
+    if (out_w) *out_w = w;
+    if (out_h) *out_h = g->height;
+    return true;
+}
+
+bool GlyphAtlas_Draw(GlyphAtlas* g, SDL_Renderer* r, float x, float y, const char* text, SDL_Color color)
+{
+    if (!r || !GlyphAtlas_Measure(g, text, NULL, NULL)) return false;
+
+    if (g->renderer != r)
+    {
+        GlyphAtlas_ReleaseTextures(g);
+        g->renderer = r;
+    }
+    if (g->atlas.page_count == 0)
+    {
+        if (g->build_failed) return false;
+        if (!build(g, r))
+        {
+            g->build_failed = true;
+            return false;
+        }
+    }
+
+    TileBatch_Begin(&g->batch, r, &g->atlas);
+    TileBatch_SetTint(&g->batch, color);
+
+    size_t len = SDL_strlen(text);
+    int pen = 0, prev = -1;
+    while (len > 0)
+    {
+        const int i = glyph_index(SDL_StepUTF8(&text, &len));
+        if (prev >= 0) pen += g->kern[prev][i];
+        if (i != 0) TileBatch_Add(&g->batch, i + 1, x + (float)pen, y);
+        pen += g->advance[i];
+        prev = i;
+    }
+
+    TileBatch_Flush(&g->batch);
+    return true;
+}
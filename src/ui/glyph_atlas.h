@@ -0,0 +1,49 @@
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+#include <SDL3/SDL.h>
+
+#include "render/atlas.h"
+#include "render/tile_batch.h"
+
+typedef struct TTF_Font TTF_Font;
+
+// Pre-rasterized glyphs of one font
+//
+// Printable Latin-1 (U+0020..U+007E, U+00A0..U+00FF) is rendered once into a
+// grid sheet of the render atlas; advances and kerning pairs are read from
+// the font up front, so measuring a string is a table walk and drawing it
+// is one tinted SDL_RenderGeometry call. Strings with any other character
+// are refused (false) and left to the caller's TTF path. The texture is
+// built on the first draw and again after GlyphAtlas_ReleaseTextures or a
+// renderer change. Main thread only.
+
+#define GLYPH_ATLAS_COUNT 191   // 95 ASCII + 96 Latin-1
+
+typedef struct GlyphAtlas
+{
+    TTF_Font* font;             // not owned
+    int height;                 // line height of every glyph cell
+
+    int advance[GLYPH_ATLAS_COUNT];
+    int8_t kern[GLYPH_ATLAS_COUNT][GLYPH_ATLAS_COUNT];   // [prev][next]
+    bool has[GLYPH_ATLAS_COUNT];                         // font covers it
+
+    SDL_Renderer* renderer;     // the atlas texture's
+    bool build_failed;          // for that renderer; falls back until it changes
+    Atlas atlas;
+    TileBatch batch;
+} GlyphAtlas;
+
+// Read the metrics of "font"; no rendering yet.
+bool GlyphAtlas_Init(GlyphAtlas* g, TTF_Font* font);
+void GlyphAtlas_Shutdown(GlyphAtlas* g);
+
+// Drop the texture (device lost); the next draw rebuilds it.
+void GlyphAtlas_ReleaseTextures(GlyphAtlas* g);
+
+// Pen width of "text" (advances plus kerning) and the line height.
+bool GlyphAtlas_Measure(const GlyphAtlas* g, const char* text, int* out_w, int* out_h);
+
+// Draw "text" with its top-left at (x, y).
+bool GlyphAtlas_Draw(GlyphAtlas* g, SDL_Renderer* r, float x, float y, const char* text, SDL_Color color);
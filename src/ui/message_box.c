@@ -4,7 +4,158 @@
 #include <SDL3/SDL.h>
 #include <string.h>
 
-void MessageBox_Open(MessageBox* mb, const char* text)
+// Box geometry (screen pixels)
+#define MB_PAD    18.0f   // screen edge to box
+#define MB_BOX_H  150.0f
+#define MB_INSET  18.0f   // box edge to text
+#define MB_HINT_H 34.0f   // bottom strip for the key hint
+
+static int text_width(const char* s)
+{
+    int w = 0, h = 0;
+    return UIText_MeasureLine(s, &w, &h) ? w : 0;
+}
+
+static bool utf8_cont(char c)
+{
+    return ((unsigned char)c & 0xC0) == 0x80;
+}
+
+// Codepoints in [s, s + len).
+static int utf8_chars(const char* s, int len)
+{
+    int n = 0;
+    for (int i = 0; i < len; ++i)
+        if (!utf8_cont(s[i])) n++;
+    return n;
+}
+
+// Byte offset of codepoint "n" of [s, s + len).
+static int utf8_offset(const char* s, int len, int n)
+{
+    int i = 0;
+    while (i < len && n > 0)
+    {
+        i++;
+        while (i < len && utf8_cont(s[i])) i++;
+        n--;
+    }
+    return i;
+}
+
+// Append [s, s + len) as the next line; false when the layout is full.
+static bool push_line(MessageBox* mb, const char* s, int len, int* used)
+{
+    if (mb->line_count == MESSAGE_BOX_MAX_LINES || *used + len + 1 > (int)sizeof(mb->lines)) return false;
+
+    memcpy(mb->lines + *used, s, (size_t)len);
+    mb->lines[*used + len] = '\0';
+    mb->line_start[mb->line_count] = (short)*used;
+    mb->line_len[mb->line_count] = (short)len;
+    mb->line_chars[mb->line_count] = (short)utf8_chars(s, len);
+    mb->line_count++;
+    *used += len + 1;
+    return true;
+}
+
+// Longest prefix of "s" (at least one character) narrower than max_w.
+static int fit_prefix(const char* s, int len, int max_w)
+{
+    char buf[MESSAGE_BOX_TEXT_MAX];
+    int best = 0;
+    for (int k = 1; k <= len; ++k)
+    {
+        if (k < len && utf8_cont(s[k])) continue;   // inside a UTF-8 sequence
+        memcpy(buf, s, (size_t)k);
+        buf[k] = '\0';
+        if (best > 0 && text_width(buf) > max_w) break;
+        best = k;
+    }
+    return best;
+}
+
+// Greedy word wrap of mb->text into lines no wider than the text area, then
+// pages of as many lines as fit above the hint.
+static void layout(MessageBox* mb, int screen_w)
+{
+    mb->layout_w = screen_w;
+    mb->line_count = 0;
+
+    int lh = 0;
+    mb->line_h = UIText_MeasureLine("Ag", NULL, &lh) && lh > 0 ? (float)lh : 24.0f;
+
+    const int max_w = (int)((float)screen_w - MB_PAD * 2.0f - MB_INSET * 2.0f);
+    char cur[MESSAGE_BOX_TEXT_MAX];     // line being filled
+    int n = 0, used = 0;
+    bool full = false;
+
+    const char* p = mb->text;
+    while (*p && !full)
+    {
+        if (*p == '\n')
+        {
+            full = !push_line(mb, cur, n, &used);
+            n = 0;
+            p++;
+            continue;
+        }
+        if (*p == ' ')
+        {
+            p++;
+            continue;
+        }
+
+        const char* word = p;
+        while (*p && *p != ' ' && *p != '\n') p++;
+        int wl = (int)(p - word);
+
+        // Try it on the current line
+        int m = n;
+        if (m > 0) cur[m++] = ' ';
+        memcpy(cur + m, word, (size_t)wl);
+        cur[m + wl] = '\0';
+        if (max_w <= 0 || text_width(cur) <= max_w)
+        {
+            n = m + wl;
+            continue;
+        }
+
+        if (n > 0) full = !push_line(mb, cur, n, &used);
+        n = 0;
+
+        // On a line of its own, broken up if it is still too wide
+        while (!full && wl > 0)
+        {
+            memcpy(cur, word, (size_t)wl);
+            cur[wl] = '\0';
+            if (text_width(cur) <= max_w)
+            {
+                n = wl;
+                break;
+            }
+            const int k = fit_prefix(word, wl, max_w);
+            full = !push_line(mb, word, k, &used);
+            word += k;
+            wl -= k;
+        }
+    }
+    if (n > 0 && !full) push_line(mb, cur, n, &used);
+
+    const float avail = MB_BOX_H - MB_INSET - MB_HINT_H;
+    mb->lines_per_page = SDL_max((int)(avail / mb->line_h), 1);
+    mb->page_count = SDL_max((mb->line_count + mb->lines_per_page - 1) / mb->lines_per_page, 1);
+}
+
+static int page_chars(const MessageBox* mb)
+{
+    const int first = mb->page * mb->lines_per_page;
+    const int last = SDL_min(first + mb->lines_per_page, mb->line_count);
+    int chars = 0;
+    for (int i = first; i < last; ++i) chars += mb->line_chars[i];
+    return chars;
+}
+
+void MessageBox_Open(MessageBox* mb, const char* text, int screen_w)
 {
     if (!mb) return;
     mb->open = true;
@@ -14,6 +165,11 @@ void MessageBox_Open(MessageBox* mb, const char* text)
         strncpy(mb->text, text, sizeof(mb->text) - 1);
         mb->text[sizeof(mb->text) - 1] = '\0';
     }
+
+    (void)UIText_Init(NULL);   // measuring needs the font only
+    layout(mb, screen_w);
+    mb->page = 0;
+    mb->reveal = 0.0f;
 }
 
 void MessageBox_Close(MessageBox* mb)
@@ -27,6 +183,33 @@ bool MessageBox_IsOpen(const MessageBox* mb)
     return mb && mb->open;
 }
 
+void MessageBox_Update(MessageBox* mb, float dt)
+{
+    if (!mb || !mb->open) return;
+
+    const float chars = (float)page_chars(mb);
+    if (mb->reveal < chars) mb->reveal = SDL_min(mb->reveal + dt * MESSAGE_BOX_REVEAL_CPS, chars);
+}
+
+bool MessageBox_Advance(MessageBox* mb)
+{
+    if (!mb || !mb->open) return false;
+
+    const float chars = (float)page_chars(mb);
+    if (mb->reveal < chars)
+    {
+        mb->reveal = chars;
+        return true;
+    }
+    if (mb->page + 1 < mb->page_count)
+    {
+        mb->page++;
+        mb->reveal = 0.0f;
+        return true;
+    }
+    return false;
+}
+
 static void fill(SDL_Renderer* r, SDL_FRect rc, Uint8 rr, Uint8 gg, Uint8 bb, Uint8 aa)
 {
     SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
@@ -47,27 +230,55 @@ void MessageBox_Render(MessageBox* mb, SDL_Renderer* r, int screen_w, int screen
 
     (void)UIText_Init(r);
 
-    const float pad = 18.0f;
-    const float box_h = 150.0f;
+    // Window resized: lay out again, keeping the page and showing it whole
+    if (screen_w != mb->layout_w)
+    {
+        layout(mb, screen_w);
+        mb->page = SDL_min(mb->page, mb->page_count - 1);
+        mb->reveal = (float)page_chars(mb);
+    }
 
     SDL_FRect dim = { 0, 0, (float)screen_w, (float)screen_h };
     fill(r, dim, 0, 0, 0, 90);
 
     SDL_FRect box = {
-        pad,
-        (float)screen_h - box_h - pad,
-        (float)screen_w - pad * 2.0f,
-        box_h
+        MB_PAD,
+        (float)screen_h - MB_BOX_H - MB_PAD,
+        (float)screen_w - MB_PAD * 2.0f,
+        MB_BOX_H
     };
 
     fill(r, box, 10, 10, 12, 215);
     outline(r, box, 200, 200, 200, 180);
 
-    const float tx = box.x + 18.0f;
-    const float ty = box.y + 18.0f;
+    const float tx = box.x + MB_INSET;
+    const float ty = box.y + MB_INSET;
 
-    if (mb->text[0])
-        UIText_DrawLine(r, tx, ty, mb->text);
+    // Current page; the line being typed is cut at the reveal point in place
+    // and kept out of the text cache, as it changes every few frames
+    const int first = mb->page * mb->lines_per_page;
+    const int last = SDL_min(first + mb->lines_per_page, mb->line_count);
+    int shown = (int)mb->reveal;
+    for (int i = first; i < last && shown > 0; ++i)
+    {
+        char* s = mb->lines + mb->line_start[i];
+        const float y = ty + (float)(i - first) * mb->line_h;
+
+        if (shown >= mb->line_chars[i])
+        {
+            UIText_DrawLine(r, tx, y, s);
+            shown -= mb->line_chars[i];
+            continue;
+        }
+
+        const int cut = utf8_offset(s, mb->line_len[i], shown);
+        const char keep = s[cut];
+        s[cut] = '\0';
+        UIText_DrawLineUncached(r, tx, y, s);
+        s[cut] = keep;
+        shown = 0;
+    }
 
-    UIText_DrawLine(r, tx, box.y + box.h - 34.0f, "E / Esc: Close");
+    const bool last_page = mb->page + 1 >= mb->page_count;
+    UIText_DrawLine(r, tx, box.y + box.h - MB_HINT_H, last_page ? "E / Esc: Close" : "E: Next   Esc: Close");
 }
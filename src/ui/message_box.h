@@ -3,14 +3,48 @@
 
 typedef struct SDL_Renderer SDL_Renderer;
 
+// Dialog box at the bottom of the screen
+//
+// MessageBox_Open word-wraps the text to the box width once (breaking long
+// words if needed) into NUL-terminated lines and splits them into pages;
+// rendering only walks the current page's lines, so the frame cost does not
+// grow with the text. The page is revealed a few characters at a time
+// (typewriter, counting UTF-8 codepoints); MessageBox_Advance skips to the end of the page, then to the
+// next one. A window resize lays the text out again on the next render.
+
+#define MESSAGE_BOX_TEXT_MAX   512
+#define MESSAGE_BOX_MAX_LINES  32      // wrapped lines kept; the rest is cut
+#define MESSAGE_BOX_REVEAL_CPS 60.0f   // typewriter speed, characters per second
+
 typedef struct MessageBox
 {
     bool open;
-    char text[512];
+    char text[MESSAGE_BOX_TEXT_MAX];
+
+    // Layout for screen width layout_w
+    char  lines[MESSAGE_BOX_TEXT_MAX + MESSAGE_BOX_MAX_LINES];
+    short line_start[MESSAGE_BOX_MAX_LINES];   // offsets into lines
+    short line_len[MESSAGE_BOX_MAX_LINES];     // bytes
+    short line_chars[MESSAGE_BOX_MAX_LINES];   // codepoints
+    int   line_count;
+    int   lines_per_page;
+    int   page_count;
+    float line_h;
+    int   layout_w;
+
+    int   page;
+    float reveal;       // characters of the page shown so far
 } MessageBox;
 
-void MessageBox_Open(MessageBox* mb, const char* text);
+void MessageBox_Open(MessageBox* mb, const char* text, int screen_w);
 void MessageBox_Close(MessageBox* mb);
 bool MessageBox_IsOpen(const MessageBox* mb);
 
+// Typewriter step.
+void MessageBox_Update(MessageBox* mb, float dt);
+
+// Finish revealing the page, or turn to the next one. False when the last
+// page was already fully shown (the caller closes the box).
+bool MessageBox_Advance(MessageBox* mb);
+
 void MessageBox_Render(MessageBox* mb, SDL_Renderer* r, int screen_w, int screen_h);
@@ -0,0 +1,199 @@
+#include "ui/text_cache.h"
+
+#include <SDL3_ttf/SDL_ttf.h>
+#include <string.h>
+
+typedef struct TextCacheEntry
+{
+    bool         used;
+    Uint32       hash;
+    char         text[TEXT_CACHE_KEY_MAX];
+    SDL_Color    color;
+    float        size;
+    TTF_Font*    font;
+    SDL_Texture* tex;
+    size_t       bytes;
+    Uint64       last_use;
+} TextCacheEntry;
+
+struct TextCache
+{
+    TextCacheEntry entries[TEXT_CACHE_MAX_ENTRIES];
+    SDL_Renderer* renderer;     // the textures'
+    size_t bytes;
+    size_t budget;
+    Uint64 clock;
+
+    unsigned hits;
+    unsigned misses;
+    unsigned evictions;
+};
+
+// FNV-1a over the text, then the color and size, so most mismatches are
+// rejected without a string compare.
+static Uint32 key_hash(const char* text, SDL_Color color, float size)
+{
+    Uint32 h = 2166136261u;
+    for (const unsigned char* p = (const unsigned char*)text; *p; ++p) h = (h ^ *p) * 16777619u;
+    const Uint8 tail[5] = { color.r, color.g, color.b, color.a, (Uint8)((int)(size * 4.0f) & 0xFF) };
+    for (int i = 0; i < 5; ++i) h = (h ^ tail[i]) * 16777619u;
+    return h;
+}
+
+static int find_entry(const TextCache* c, Uint32 hash, TTF_Font* font, float size,
+                      const char* text, SDL_Color color)
+{
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; ++i)
+    {
+        const TextCacheEntry* e = &c->entries[i];
+        if (!e->used || e->hash != hash || e->font != font || e->size != size) continue;
+        if (e->color.r != color.r || e->color.g != color.g || e->color.b != color.b || e->color.a != color.a) continue;
+        if (SDL_strcmp(e->text, text) == 0) return i;
+    }
+    return -1;
+}
+
+static void free_entry(TextCache* c, TextCacheEntry* e)
+{
+    SDL_DestroyTexture(e->tex);
+    c->bytes -= e->bytes;
+    memset(e, 0, sizeof(*e));
+}
+
+static int find_lru(const TextCache* c)
+{
+    int lru = -1;
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; ++i)
+    {
+        if (!c->entries[i].used) continue;
+        if (lru < 0 || c->entries[i].last_use < c->entries[lru].last_use) lru = i;
+    }
+    return lru;
+}
+
+// Evict until "extra" more bytes fit.
+static void evict_for(TextCache* c, size_t extra)
+{
+    while (c->bytes + extra > c->budget)
+    {
+        const int lru = find_lru(c);
+        if (lru < 0) break;
+        free_entry(c, &c->entries[lru]);
+        c->evictions++;
+    }
+}
+
+TextCache* TextCache_Create(size_t budget_bytes)
+{
+    TextCache* c = (TextCache*)SDL_calloc(1, sizeof(TextCache));
+    if (!c) return NULL;
+    c->budget = budget_bytes;
+    return c;
+}
+
+void TextCache_Destroy(TextCache* c)
+{
+    if (!c) return;
+    TextCache_Clear(c);
+    SDL_free(c);
+}
+
+void TextCache_Clear(TextCache* c)
+{
+    if (!c) return;
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; ++i)
+        if (c->entries[i].used) free_entry(c, &c->entries[i]);
+    c->renderer = NULL;
+}
+
+SDL_Texture* TextCache_Get(TextCache* c, SDL_Renderer* r, TTF_Font* font, const char* text, SDL_Color color)
+{
+    if (!c || !r || !font || !text || !text[0]) return NULL;
+
+    const size_t len = SDL_strlen(text);
+    if (len >= TEXT_CACHE_KEY_MAX) return NULL;
+
+    if (c->renderer != r)
+    {
+        TextCache_Clear(c);
+        c->renderer = r;
+    }
+
+    const float size = TTF_GetFontSize(font);
+    const Uint32 hash = key_hash(text, color, size);
+    const int hit = find_entry(c, hash, font, size, text, color);
+    if (hit >= 0)
+    {
+        c->hits++;
+        c->entries[hit].last_use = ++c->clock;
+        return c->entries[hit].tex;
+    }
+
+    // Too big to keep: leave it to the caller without rasterizing it here
+    int w = 0, h = 0;
+    if (!TTF_GetStringSize(font, text, 0, &w, &h) || (size_t)w * (size_t)h * 4 > c->budget) return NULL;
+    c->misses++;
+
+    // length=0 => null-terminated (SDL3_ttf)
+    SDL_Surface* s = TTF_RenderText_Blended(font, text, 0, color);
+    if (!s)
+    {
+        SDL_Log("TTF_RenderText_Blended failed: %s", SDL_GetError());
+        return NULL;
+    }
+
+    const size_t bytes = (size_t)s->w * (size_t)s->h * 4;
+    if (bytes > c->budget)
+    {
+        SDL_DestroySurface(s);
+        return NULL;
+    }
+
+    SDL_Texture* tex = SDL_CreateTextureFromSurface(r, s);
+    SDL_DestroySurface(s);
+    if (!tex)
+    {
+        SDL_Log("SDL_CreateTextureFromSurface failed: %s", SDL_GetError());
+        return NULL;
+    }
+
+    evict_for(c, bytes);
+
+    int slot = -1;
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES && slot < 0; ++i)
+        if (!c->entries[i].used) slot = i;
+    if (slot < 0)
+    {
+        slot = find_lru(c);
+        free_entry(c, &c->entries[slot]);
+        c->evictions++;
+    }
+
+    TextCacheEntry* e = &c->entries[slot];
+    e->used = true;
+    e->hash = hash;
+    memcpy(e->text, text, len + 1);
+    e->color = color;
+    e->size = size;
+    e->font = font;
+    e->tex = tex;
+    e->bytes = bytes;
+    e->last_use = ++c->clock;
+    c->bytes += bytes;
+    return tex;
+}
+
+void TextCache_GetStats(const TextCache* c, TextCacheStats* out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!c) return;
+
+    out->hits = c->hits;
+    out->misses = c->misses;
+    out->evictions = c->evictions;
+    out->bytes = c->bytes;
+    out->budget = c->budget;
+    for (int i = 0; i < TEXT_CACHE_MAX_ENTRIES; ++i)
+        if (c->entries[i].used) out->count++;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <SDL3/SDL.h>
+
+typedef struct TTF_Font TTF_Font;
+typedef struct TextCache TextCache;
+
+// LRU cache of rendered string textures, keyed by text, color and font size
+//
+// A miss rasterizes the string with TTF_RenderText_Blended and uploads it
+// once; hits hand back the same texture until it is evicted. Texture bytes
+// (w * h * 4) stay within the budget, least recently used first. Textures
+// belong to one renderer: a different renderer empties the cache. Main
+// thread only.
+
+#define TEXT_CACHE_MAX_ENTRIES    64
+#define TEXT_CACHE_KEY_MAX        512     // longer strings are not cached
+#define TEXT_CACHE_DEFAULT_BUDGET ((size_t)4 * 1024 * 1024)
+
+typedef struct TextCacheStats
+{
+    unsigned hits;
+    unsigned misses;
+    unsigned evictions;
+    int      count;     // textures currently cached
+    size_t   bytes;
+    size_t   budget;
+} TextCacheStats;
+
+TextCache* TextCache_Create(size_t budget_bytes);
+void TextCache_Destroy(TextCache* c);
+
+// Free every texture (render device lost). Counters are kept.
+void TextCache_Clear(TextCache* c);
+
+// Texture of "text" in "font" and "color", owned by the cache and valid
+// until the next Get or Clear. NULL if it cannot be rendered or cached;
+// the caller then renders it itself. Strings too long for a key or too big
+// for the budget are refused before rasterizing and are not counted as
+// misses.
+SDL_Texture* TextCache_Get(TextCache* c, SDL_Renderer* r, TTF_Font* font, const char* text, SDL_Color color);
+
+void TextCache_GetStats(const TextCache* c, TextCacheStats* out);
@@ -1,4 +1,6 @@
 #include "ui/ui_text.h"
+#include "ui/glyph_atlas.h"
+#include "ui/text_cache.h"
 
 #include <SDL3/SDL.h>
 #include <SDL3_ttf/SDL_ttf.h>
@@ -6,6 +8,8 @@
 
 static bool g_inited = false;
 static TTF_Font* g_font = NULL;
+static GlyphAtlas g_glyphs;     // Latin-1 fast path; other text goes through TTF
+static TextCache* g_cache = NULL;   // TTF-rendered strings
 
 static const char* kFontTry1 = "assets/fonts/DejaVuSans.ttf";
 static const char* kFontTry2 = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
@@ -36,6 +40,9 @@ bool UIText_Init(SDL_Renderer* renderer)
         return false;
     }
 
+    GlyphAtlas_Init(&g_glyphs, g_font);
+    g_cache = TextCache_Create(TEXT_CACHE_DEFAULT_BUDGET);
+
     g_inited = true;
     SDL_Log("UIText_Init OK (font loaded)");
     return true;
@@ -43,6 +50,9 @@ bool UIText_Init(SDL_Renderer* renderer)
 
 void UIText_Shutdown(void)
 {
+    GlyphAtlas_Shutdown(&g_glyphs);
+    TextCache_Destroy(g_cache);
+    g_cache = NULL;
     if (g_font)
     {
         TTF_CloseFont(g_font);
@@ -55,30 +65,52 @@ void UIText_Shutdown(void)
     }
 }
 
+void UIText_ReleaseTextures(void)
+{
+    GlyphAtlas_ReleaseTextures(&g_glyphs);
+    TextCache_Clear(g_cache);
+}
+
+void UIText_GetCacheStats(TextCacheStats* out)
+{
+    TextCache_GetStats(g_cache, out);
+}
+
 bool UIText_MeasureLine(const char* text, int* out_w, int* out_h)
 {
     if (!g_font || !text || !text[0]) return false;
 
-    SDL_Color fg = { 255, 255, 255, 255 };
-
-    // length=0 => null-terminated (SDL3_ttf)
-    SDL_Surface* s = TTF_RenderText_Blended(g_font, text, 0, fg);
-    if (!s) return false;
+    if (GlyphAtlas_Measure(&g_glyphs, text, out_w, out_h)) return true;
 
-    if (out_w) *out_w = s->w;
-    if (out_h) *out_h = s->h;
+    // length=0 => null-terminated (SDL3_ttf); metrics only, nothing rendered
+    int w = 0, h = 0;
+    if (!TTF_GetStringSize(g_font, text, 0, &w, &h)) return false;
 
-    SDL_DestroySurface(s);
+    if (out_w) *out_w = w;
+    if (out_h) *out_h = h;
     return true;
 }
 
-bool UIText_DrawLine(SDL_Renderer* renderer, float x, float y, const char* text)
+static bool draw_line(SDL_Renderer* renderer, float x, float y, const char* text, bool use_cache)
 {
     if (!renderer || !text || !text[0]) return false;
     if (!g_font) return false;
 
     SDL_Color fg = { 240, 240, 240, 255 };
 
+    if (GlyphAtlas_Draw(&g_glyphs, renderer, x, y, text, fg)) return true;
+
+    SDL_Texture* cached = use_cache ? TextCache_Get(g_cache, renderer, g_font, text, fg) : NULL;
+    if (cached)
+    {
+        float tw = 0.0f, th = 0.0f;
+        SDL_GetTextureSize(cached, &tw, &th);
+
+        SDL_FRect dst = { x, y, tw, th };
+        SDL_RenderTexture(renderer, cached, NULL, &dst);
+        return true;
+    }
+
     SDL_Surface* s = TTF_RenderText_Blended(g_font, text, 0, fg);
     if (!s)
     {
@@ -104,3 +136,13 @@ bool UIText_DrawLine(SDL_Renderer* renderer, float x, float y, const char* text)
     SDL_DestroyTexture(t);
     return true;
 }
+
+bool UIText_DrawLine(SDL_Renderer* renderer, float x, float y, const char* text)
+{
+    return draw_line(renderer, x, y, text, true);
+}
+
+bool UIText_DrawLineUncached(SDL_Renderer* renderer, float x, float y, const char* text)
+{
+    return draw_line(renderer, x, y, text, false);
+}
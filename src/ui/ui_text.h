@@ -2,9 +2,21 @@
 #include <stdbool.h>
 
 typedef struct SDL_Renderer SDL_Renderer;
+typedef struct TextCacheStats TextCacheStats;
 
 bool UIText_Init(SDL_Renderer* renderer);
 void UIText_Shutdown(void);
 
+// Drop cached textures after the render device was lost; rebuilt on demand.
+void UIText_ReleaseTextures(void);
+
+// Counters of the string texture cache behind the glyph atlas (text the
+// atlas cannot draw is rendered once per string and color, then reused).
+void UIText_GetCacheStats(TextCacheStats* out);
+
 bool UIText_MeasureLine(const char* text, int* out_w, int* out_h);
 bool UIText_DrawLine(SDL_Renderer* renderer, float x, float y, const char* text);
+
+// Same, but text the glyph atlas cannot draw is not kept in the cache; for
+// strings that change every frame (a line being typed out).
+bool UIText_DrawLineUncached(SDL_Renderer* renderer, float x, float y, const char* text);
@@ -0,0 +1,101 @@
+// src/world/autotile.c
+#include "autotile.h"
+#include "layered_map.h"
+#include "tile_props.h"
+
+#include <SDL3/SDL.h>
+
+// Columns per sweep step; with the two neighbor columns a step reads one
+// LAYERED_MAP_SPAN_MAX row span.
+#define AUTOTILE_SPAN (LAYERED_MAP_SPAN_MAX - 2)
+#define KEY_OFF_MAP   (-1)
+
+// keys[i] for columns x0-1+i, i in [0, count+2): the deco id if it is
+// autotiled, 0 if not, KEY_OFF_MAP outside the map.
+static void load_keys(const Autotile* a, const LayeredMap* m, int x0, int count, int ty, int* keys)
+{
+    const int n = count + 2;
+    if (ty < 0 || ty >= a->height)
+    {
+        for (int i = 0; i < n; ++i) keys[i] = KEY_OFF_MAP;
+        return;
+    }
+
+    const int xa = SDL_max(x0 - 1, 0), xb = SDL_min(x0 + count + 1, a->width);
+    int buf[LAYERED_MAP_SPAN_MAX];
+    const int* row = LayeredMap_Row(m, MAP_LAYER_DECO, xa, ty, xb - xa, buf);
+
+    for (int i = 0; i < n; ++i) keys[i] = KEY_OFF_MAP;
+    for (int x = xa; x < xb; ++x)
+    {
+        const int id = row[x - xa];
+        keys[x - x0 + 1] = ((unsigned)id < TILE_PROPS_MAX_IDS && a->props->autotile[id]) ? id : 0;
+    }
+}
+
+// Masks for tiles [x0, x0+count) of row ty. Branch-free per tile.
+static void sweep(Autotile* a, const LayeredMap* m, int x0, int count, int ty)
+{
+    int up[LAYERED_MAP_SPAN_MAX], mid[LAYERED_MAP_SPAN_MAX], down[LAYERED_MAP_SPAN_MAX];
+    load_keys(a, m, x0, count, ty - 1, up);
+    load_keys(a, m, x0, count, ty, mid);
+    load_keys(a, m, x0, count, ty + 1, down);
+
+    uint8_t* out = a->mask + (size_t)ty * (size_t)a->width + (size_t)x0;
+    for (int i = 0; i < count; ++i)
+    {
+        const int k = mid[i + 1];
+        const unsigned n = (unsigned)(up[i + 1] == k || up[i + 1] == KEY_OFF_MAP);
+        const unsigned e = (unsigned)(mid[i + 2] == k || mid[i + 2] == KEY_OFF_MAP);
+        const unsigned s = (unsigned)(down[i + 1] == k || down[i + 1] == KEY_OFF_MAP);
+        const unsigned w = (unsigned)(mid[i] == k || mid[i] == KEY_OFF_MAP);
+        const unsigned bits = n | (e << 1) | (s << 2) | (w << 3);
+        out[i] = (uint8_t)(bits & (0u - (unsigned)(k > 0)));
+    }
+}
+
+Autotile* Autotile_Build(const LayeredMap* m, const TileProps* props)
+{
+    if (!m || !props || !props->any_autotile || m->width <= 0 || m->height <= 0 || m->stream) return NULL;
+
+    Autotile* a = (Autotile*)SDL_calloc(1, sizeof(Autotile));
+    if (!a) return NULL;
+
+    a->width = m->width;
+    a->height = m->height;
+    a->props = props;
+    a->mask = (uint8_t*)SDL_malloc((size_t)m->width * (size_t)m->height);
+    if (!a->mask)
+    {
+        SDL_Log("Autotile_Build: out of memory for %dx%d", m->width, m->height);
+        SDL_free(a);
+        return NULL;
+    }
+
+    for (int ty = 0; ty < m->height; ++ty)
+        for (int x = 0; x < m->width; x += AUTOTILE_SPAN)
+            sweep(a, m, x, SDL_min(m->width - x, AUTOTILE_SPAN), ty);
+    return a;
+}
+
+void Autotile_Destroy(Autotile* a)
+{
+    if (!a) return;
+    SDL_free(a->mask);
+    SDL_free(a);
+}
+
+void Autotile_Update(Autotile* a, const LayeredMap* m, int tx, int ty)
+{
+    if (!a || !m) return;
+
+    const int x0 = SDL_max(tx - 1, 0), x1 = SDL_min(tx + 2, a->width);
+    if (x1 <= x0) return;
+    for (int y = SDL_max(ty - 1, 0); y < SDL_min(ty + 2, a->height); ++y)
+        sweep(a, m, x0, x1 - x0, y);
+}
+
+size_t Autotile_MemoryBytes(const Autotile* a)
+{
+    return a ? sizeof(Autotile) + (size_t)a->width * (size_t)a->height : 0;
+}
@@ -0,0 +1,39 @@
+// src/world/autotile.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct LayeredMap LayeredMap;
+typedef struct TileProps TileProps;
+
+// Autotile masks for the deco layer
+//
+// For every tile whose deco id has an "autotile=" property, the mask of
+// neighbors holding the same id (TILE_AUTOTILE_N/E/S/W; off-map counts as
+// the same). Masks are computed for the whole map in one row sweep at load
+// and for the 3x3 block around each later deco edit, so drawing a variant
+// is TileProps_AutotileId(props, id, mask) with no neighbor reads.
+
+typedef struct Autotile
+{
+    int width;
+    int height;
+    const TileProps* props;   // must outlive the masks
+    uint8_t* mask;            // width * height, 0 where deco is not autotiled
+} Autotile;
+
+// NULL on failure, or when "props" declares no autotiled ids.
+Autotile* Autotile_Build(const LayeredMap* m, const TileProps* props);
+void Autotile_Destroy(Autotile* a);
+
+// Deco tile (tx, ty) changed: recompute it and its 8 neighbors.
+void Autotile_Update(Autotile* a, const LayeredMap* m, int tx, int ty);
+
+// Masks of tiles [tx0, ...) in row ty.
+static inline const uint8_t* Autotile_Row(const Autotile* a, int tx0, int ty)
+{
+    return a->mask + (size_t)ty * (size_t)a->width + (size_t)tx0;
+}
+
+size_t Autotile_MemoryBytes(const Autotile* a);
@@ -0,0 +1,218 @@
+// src/world/coll_rects.c
+#include "coll_rects.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+static bool push_rect(CollRects* c, int* cap, CollRect r)
+{
+    if (c->count == *cap)
+    {
+        const int next = *cap ? *cap * 2 : 64;
+        CollRect* p = (CollRect*)SDL_realloc(c->rects, sizeof(CollRect) * (size_t)next);
+        if (!p) return false;
+        c->rects = p;
+        *cap = next;
+    }
+    c->rects[c->count++] = r;
+    return true;
+}
+
+// Greedy merge over a byte grid of unclaimed solid tiles.
+static bool merge_rects(CollRects* c, unsigned char* grid)
+{
+    const int w = c->width, h = c->height;
+    int cap = 0;
+
+    for (int y = 0; y < h; ++y)
+    {
+        for (int x = 0; x < w; ++x)
+        {
+            if (!grid[(size_t)y * w + x]) continue;
+
+            int tw = 1;
+            while (x + tw < w && grid[(size_t)y * w + x + tw]) tw++;
+
+            int th = 1;
+            while (y + th < h)
+            {
+                const unsigned char* row = grid + (size_t)(y + th) * w + x;
+                int i = 0;
+                while (i < tw && row[i]) i++;
+                if (i < tw) break;
+                th++;
+            }
+
+            for (int ry = y; ry < y + th; ++ry)
+                memset(grid + (size_t)ry * w + x, 0, (size_t)tw);
+
+            const CollRect r = { x, y, tw, th };
+            if (!push_rect(c, &cap, r)) return false;
+        }
+    }
+    return true;
+}
+
+// Cell range [cx0,cx1] x [cy0,cy1] a tile rect touches, clipped to the grid.
+static bool cell_range(const CollRects* c, int tx0, int ty0, int tx1, int ty1,
+                       int* cx0, int* cy0, int* cx1, int* cy1)
+{
+    if (tx0 < 0) tx0 = 0;
+    if (ty0 < 0) ty0 = 0;
+    if (tx1 > c->width)  tx1 = c->width;
+    if (ty1 > c->height) ty1 = c->height;
+    if (tx0 >= tx1 || ty0 >= ty1) return false;
+
+    *cx0 = tx0 >> COLL_RECTS_CELL_SHIFT;
+    *cy0 = ty0 >> COLL_RECTS_CELL_SHIFT;
+    *cx1 = (tx1 - 1) >> COLL_RECTS_CELL_SHIFT;
+    *cy1 = (ty1 - 1) >> COLL_RECTS_CELL_SHIFT;
+    return true;
+}
+
+static bool build_index(CollRects* c)
+{
+    c->cells_w = (c->width + COLL_RECTS_CELL - 1) >> COLL_RECTS_CELL_SHIFT;
+    c->cells_h = (c->height + COLL_RECTS_CELL - 1) >> COLL_RECTS_CELL_SHIFT;
+    const size_t cells = (size_t)c->cells_w * (size_t)c->cells_h;
+
+    c->cell_start = (int*)SDL_calloc(cells + 1, sizeof(int));
+    if (!c->cell_start) return false;
+
+    // Count, prefix-sum, then fill (cell_start[i + 1] doubles as the cursor).
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        for (int i = 0; i < c->count; ++i)
+        {
+            const CollRect* r = &c->rects[i];
+            int cx0 = 0, cy0 = 0, cx1 = -1, cy1 = -1;
+            cell_range(c, r->tx, r->ty, r->tx + r->tw, r->ty + r->th, &cx0, &cy0, &cx1, &cy1);
+
+            for (int cy = cy0; cy <= cy1; ++cy)
+            {
+                for (int cx = cx0; cx <= cx1; ++cx)
+                {
+                    const size_t cell = (size_t)cy * c->cells_w + cx;
+                    if (pass == 0) c->cell_start[cell + 1]++;
+                    else c->cell_items[c->cell_start[cell + 1]++] = i;
+                }
+            }
+        }
+
+        if (pass == 0)
+        {
+            for (size_t k = 0; k < cells; ++k) c->cell_start[k + 1] += c->cell_start[k];
+
+            c->cell_items = (int*)SDL_malloc(sizeof(int) * (size_t)SDL_max(c->cell_start[cells], 1));
+            if (!c->cell_items) return false;
+
+            // Rewind the cursors to each cell's start
+            for (size_t k = cells; k > 0; --k) c->cell_start[k] = c->cell_start[k - 1];
+            c->cell_start[0] = 0;
+        }
+    }
+    return true;
+}
+
+CollRects* CollRects_Bake(const LayeredMap* m)
+{
+    if (!m || m->width <= 0 || m->height <= 0 || m->stream) return NULL;
+
+    CollRects* c = (CollRects*)SDL_calloc(1, sizeof(CollRects));
+    unsigned char* grid = (unsigned char*)SDL_malloc((size_t)m->width * (size_t)m->height);
+    int* row = (int*)SDL_malloc(sizeof(int) * (size_t)m->width);
+    bool ok = c && grid && row;
+
+    if (ok)
+    {
+        c->width = m->width;
+        c->height = m->height;
+
+        for (int y = 0; y < m->height; ++y)
+        {
+            const int* solid = LayeredMap_Row(m, MAP_LAYER_COLL, 0, y, m->width, row);
+            unsigned char* g = grid + (size_t)y * m->width;
+            for (int x = 0; x < m->width; ++x) g[x] = (unsigned char)(solid[x] != 0);
+        }
+
+        ok = merge_rects(c, grid) && build_index(c);
+    }
+
+    SDL_free(grid);
+    SDL_free(row);
+    if (!ok)
+    {
+        SDL_Log("CollRects_Bake: out of memory for %dx%d", m->width, m->height);
+        CollRects_Destroy(c);
+        return NULL;
+    }
+    return c;
+}
+
+void CollRects_Destroy(CollRects* c)
+{
+    if (!c) return;
+    SDL_free(c->rects);
+    SDL_free(c->cell_start);
+    SDL_free(c->cell_items);
+    SDL_free(c);
+}
+
+static bool overlaps(const CollRect* r, int tx0, int ty0, int tx1, int ty1)
+{
+    return r->tx < tx1 && r->tx + r->tw > tx0 && r->ty < ty1 && r->ty + r->th > ty0;
+}
+
+bool CollRects_Any(const CollRects* c, int tx0, int ty0, int tx1, int ty1)
+{
+    int cx0, cy0, cx1, cy1;
+    if (!c || !cell_range(c, tx0, ty0, tx1, ty1, &cx0, &cy0, &cx1, &cy1)) return false;
+
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+            const size_t cell = (size_t)cy * c->cells_w + cx;
+            for (int k = c->cell_start[cell]; k < c->cell_start[cell + 1]; ++k)
+                if (overlaps(&c->rects[c->cell_items[k]], tx0, ty0, tx1, ty1)) return true;
+        }
+    }
+    return false;
+}
+
+bool CollRects_Visit(const CollRects* c, int tx0, int ty0, int tx1, int ty1, CollRectVisitor visit, void* user)
+{
+    int cx0, cy0, cx1, cy1;
+    if (!c || !visit || !cell_range(c, tx0, ty0, tx1, ty1, &cx0, &cy0, &cx1, &cy1)) return true;
+
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+            const size_t cell = (size_t)cy * c->cells_w + cx;
+            for (int k = c->cell_start[cell]; k < c->cell_start[cell + 1]; ++k)
+            {
+                const CollRect* r = &c->rects[c->cell_items[k]];
+                if (!overlaps(r, tx0, ty0, tx1, ty1)) continue;
+
+                // A rect spanning several cells is reported from the first
+                // cell (in scan order) that both it and the query touch.
+                const int first_cx = SDL_max(r->tx >> COLL_RECTS_CELL_SHIFT, cx0);
+                const int first_cy = SDL_max(r->ty >> COLL_RECTS_CELL_SHIFT, cy0);
+                if (cx != first_cx || cy != first_cy) continue;
+
+                if (!visit(user, r)) return false;
+            }
+        }
+    }
+    return true;
+}
+
+size_t CollRects_MemoryBytes(const CollRects* c)
+{
+    if (!c) return 0;
+    const size_t cells = (size_t)c->cells_w * (size_t)c->cells_h;
+    return sizeof(CollRects) + sizeof(CollRect) * (size_t)c->count +
+           sizeof(int) * (cells + 1) + sizeof(int) * (size_t)(c->cell_start ? c->cell_start[cells] : 0);
+}
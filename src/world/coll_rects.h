@@ -0,0 +1,54 @@
+// src/world/coll_rects.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct LayeredMap LayeredMap;
+
+// Solid tiles merged into axis-aligned rectangles.
+//
+// The bake walks the collision layer in row order; each unclaimed solid tile
+// starts a rect that grows right as far as it can, then down while the whole
+// span stays solid. Walls and room outlines collapse to a handful of rects.
+// A uniform grid of COLL_RECTS_CELL-tile cells lists the rects touching each
+// cell, so a query looks only at nearby rects.
+
+#define COLL_RECTS_CELL_SHIFT 4
+#define COLL_RECTS_CELL       (1 << COLL_RECTS_CELL_SHIFT)
+
+typedef struct CollRect
+{
+    int tx, ty;   // top-left tile
+    int tw, th;   // size in tiles
+} CollRect;
+
+typedef struct CollRects
+{
+    int width;           // map size in tiles
+    int height;
+
+    CollRect* rects;
+    int count;
+
+    int cells_w;
+    int cells_h;
+    int* cell_start;     // cells_w * cells_h + 1 offsets into cell_items
+    int* cell_items;     // rect indices per cell
+
+    bool stale;          // the collision layer changed since the bake
+} CollRects;
+
+// Called once per rect touching the query; return false to stop.
+typedef bool (*CollRectVisitor)(void* user, const CollRect* r);
+
+CollRects* CollRects_Bake(const LayeredMap* m);
+void CollRects_Destroy(CollRects* c);
+
+// Any rect overlapping the tile rect [tx0,tx1) x [ty0,ty1)?
+bool CollRects_Any(const CollRects* c, int tx0, int ty0, int tx1, int ty1);
+
+// Visit each rect overlapping [tx0,tx1) x [ty0,ty1) exactly once. Returns
+// false if the visitor stopped early.
+bool CollRects_Visit(const CollRects* c, int tx0, int ty0, int tx1, int ty1, CollRectVisitor visit, void* user);
+
+size_t CollRects_MemoryBytes(const CollRects* c);
@@ -0,0 +1,86 @@
+// src/world/coll_table.c
+#include "coll_table.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+// Recompute rows >= stale_y, columns >= stale_x. Column stale_x of the
+// table (tiles left of it) is still valid and seeds each row's running sum.
+static void refresh(CollTable* t, const LayeredMap* m)
+{
+    const size_t stride = (size_t)t->width + 1;
+    const int x0 = t->stale_x;
+    const int n = t->width - x0;
+
+    for (int y = t->stale_y; y < t->height; ++y)
+    {
+        const uint32_t* above = t->sum + (size_t)y * stride;
+        uint32_t* cur = t->sum + (size_t)(y + 1) * stride;
+
+        const int* solid = LayeredMap_Row(m, MAP_LAYER_COLL, x0, y, n, t->row);
+        uint32_t running = cur[x0] - above[x0];
+        for (int i = 0; i < n; ++i)
+        {
+            running += (uint32_t)solid[i];
+            cur[x0 + i + 1] = above[x0 + i + 1] + running;
+        }
+    }
+
+    t->stale_x = t->width;
+    t->stale_y = t->height;
+}
+
+CollTable* CollTable_Build(const LayeredMap* m)
+{
+    if (!m || m->width <= 0 || m->height <= 0 || m->stream) return NULL;
+
+    CollTable* t = (CollTable*)SDL_calloc(1, sizeof(CollTable));
+    if (!t) return NULL;
+
+    t->width = m->width;
+    t->height = m->height;
+    t->sum = (uint32_t*)SDL_calloc(((size_t)m->width + 1) * ((size_t)m->height + 1), sizeof(uint32_t));
+    t->row = (int*)SDL_malloc(sizeof(int) * (size_t)m->width);
+    if (!t->sum || !t->row)
+    {
+        SDL_Log("CollTable_Build: out of memory for %dx%d", m->width, m->height);
+        CollTable_Destroy(t);
+        return NULL;
+    }
+
+    refresh(t, m);
+    return t;
+}
+
+void CollTable_Destroy(CollTable* t)
+{
+    if (!t) return;
+    SDL_free(t->sum);
+    SDL_free(t->row);
+    SDL_free(t);
+}
+
+void CollTable_Invalidate(CollTable* t, int tx, int ty)
+{
+    if (!t) return;
+    if (tx < t->stale_x) t->stale_x = SDL_max(tx, 0);
+    if (ty < t->stale_y) t->stale_y = SDL_max(ty, 0);
+}
+
+int CollTable_Count(CollTable* t, const LayeredMap* m, int tx0, int ty0, int tx1, int ty1)
+{
+    if (t->stale_y < t->height) refresh(t, m);
+
+    const size_t stride = (size_t)t->width + 1;
+    const uint32_t* top = t->sum + (size_t)ty0 * stride;
+    const uint32_t* bottom = t->sum + (size_t)ty1 * stride;
+    return (int)(bottom[tx1] - bottom[tx0] - top[tx1] + top[tx0]);
+}
+
+size_t CollTable_MemoryBytes(const CollTable* t)
+{
+    if (!t) return 0;
+    return sizeof(CollTable) + ((size_t)t->width + 1) * ((size_t)t->height + 1) * sizeof(uint32_t) +
+           sizeof(int) * (size_t)t->width;
+}
@@ -0,0 +1,39 @@
+// src/world/coll_table.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct LayeredMap LayeredMap;
+
+// Summed-area table of the collision layer.
+//
+// sum[y * (width + 1) + x] is the number of solid tiles in [0,x) x [0,y), so
+// the solid count of any rectangle is four lookups. An edit only marks the
+// table stale from that tile down and to the right; the next query
+// recomputes just that corner.
+
+typedef struct CollTable
+{
+    int width;
+    int height;
+
+    uint32_t* sum;     // (width + 1) * (height + 1), row 0 and column 0 are zero
+    int* row;          // width ints of scratch for refreshes
+
+    int stale_x;       // first stale tile column / row; width/height when current
+    int stale_y;
+} CollTable;
+
+// Build from the map's collision layer (any storage). NULL on failure.
+CollTable* CollTable_Build(const LayeredMap* m);
+void CollTable_Destroy(CollTable* t);
+
+// Tile (tx, ty) of the collision layer changed.
+void CollTable_Invalidate(CollTable* t, int tx, int ty);
+
+// Solid tiles in [tx0,tx1) x [ty0,ty1), which must lie inside the map "t"
+// was built from. Refreshes a stale table first.
+int CollTable_Count(CollTable* t, const LayeredMap* m, int tx0, int ty0, int tx1, int ty1);
+
+size_t CollTable_MemoryBytes(const CollTable* t);
@@ -1,15 +1,54 @@
 // src/world/layered_map.c
 #include "layered_map.h"
+#include "autotile.h"
+#include "coll_rects.h"
+#include "coll_table.h"
+#include "map_regions.h"
+#include "tile_props.h"
+#include "map_binary.h"
+#include "map_stream.h"
+#include "map_text.h"
+#include "sparse_layer.h"
 
 #include <SDL3/SDL.h>
-#include <ctype.h>
-#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+static void track_destroy(LayeredMapTrack* t);
+
 static void free_layers(LayeredMap* m)
 {
     if (!m) return;
+
+    if (m->stream)
+    {
+        MapStream_Close(m->stream);
+        m->stream = NULL;
+    }
+
+    SparseLayer_Destroy(m->deco_sparse);     m->deco_sparse = NULL;
+    SparseLayer_Destroy(m->interact_sparse); m->interact_sparse = NULL;
+
+    if (m->packed)
+    {
+        SDL_aligned_free(m->packed);
+        m->packed = NULL;
+        m->ground16 = m->deco16 = NULL;
+        m->interact8 = NULL;
+        m->coll_bits = NULL;
+        m->packed_size = 0;
+    }
+
+    if (m->backing)
+    {
+        // Layers live inside the mapping; nothing was allocated per layer.
+        MapBinary_Unmap(m->backing, m->backing_size);
+        m->backing = NULL;
+        m->backing_size = 0;
+        m->ground = m->deco = m->coll = m->interact = NULL;
+        return;
+    }
+
     free(m->ground);   m->ground = NULL;
     free(m->deco);     m->deco = NULL;
     free(m->coll);     m->coll = NULL;
@@ -45,6 +84,11 @@ void LayeredMap_Shutdown(LayeredMap* m)
 {
     if (!m) return;
     free_layers(m);
+    track_destroy(m->track);
+    CollTable_Destroy(m->coll_table);
+    CollRects_Destroy(m->coll_rects);
+    MapRegions_Destroy(m->regions);
+    Autotile_Destroy(m->autotile);
     memset(m, 0, sizeof(*m));
 }
 
@@ -53,213 +97,778 @@ static int idx(const LayeredMap* m, int tx, int ty)
     return ty * m->width + tx;
 }
 
+// Index into the packed arrays.
+static size_t packed_idx(const LayeredMap* m, int tx, int ty)
+{
+#if LAYERED_MAP_BLOCKED
+    const int shift = LAYERED_MAP_BLOCK_SHIFT, mask = (1 << shift) - 1;
+    const size_t blocks_w = ((size_t)m->width + (size_t)mask) >> shift;
+    const size_t block = (size_t)(ty >> shift) * blocks_w + (size_t)(tx >> shift);
+    return (block << (2 * shift)) | (size_t)((ty & mask) << shift) | (size_t)(tx & mask);
+#else
+    return (size_t)ty * (size_t)m->width + (size_t)tx;
+#endif
+}
+
+// Tiles per packed layer; blocked maps are padded to whole blocks.
+static size_t packed_cells(const LayeredMap* m)
+{
+#if LAYERED_MAP_BLOCKED
+    const int shift = LAYERED_MAP_BLOCK_SHIFT, mask = (1 << shift) - 1;
+    const size_t blocks_w = ((size_t)m->width + (size_t)mask) >> shift;
+    const size_t blocks_h = ((size_t)m->height + (size_t)mask) >> shift;
+    return (blocks_w * blocks_h) << (2 * shift);
+#else
+    return (size_t)m->width * (size_t)m->height;
+#endif
+}
+
+static bool in_bounds(const LayeredMap* m, int tx, int ty)
+{
+    return tx >= 0 && ty >= 0 && tx < m->width && ty < m->height;
+}
+
 int LayeredMap_Ground(const LayeredMap* m, int tx, int ty)
 {
-    if (!m || !m->ground) return 0;
-    if (tx < 0 || ty < 0 || tx >= m->width || ty >= m->height) return 0;
-    return m->ground[idx(m, tx, ty)];
+    if (!m || !in_bounds(m, tx, ty)) return 0;
+    if (m->ground) return m->ground[idx(m, tx, ty)];
+    if (m->ground16) return m->ground16[packed_idx(m, tx, ty)];
+    if (m->stream) return MapStream_Tile(m->stream, MAP_LAYER_GROUND, tx, ty, 0);
+    return 0;
 }
 
 int LayeredMap_Deco(const LayeredMap* m, int tx, int ty)
 {
-    if (!m || !m->deco) return 0;
-    if (tx < 0 || ty < 0 || tx >= m->width || ty >= m->height) return 0;
-    return m->deco[idx(m, tx, ty)];
+    if (!m || !in_bounds(m, tx, ty)) return 0;
+    if (m->deco) return m->deco[idx(m, tx, ty)];
+    if (m->deco16) return m->deco16[packed_idx(m, tx, ty)];
+    if (m->deco_sparse) return SparseLayer_Get(m->deco_sparse, tx, ty);
+    if (m->stream) return MapStream_Tile(m->stream, MAP_LAYER_DECO, tx, ty, 0);
+    return 0;
 }
 
 int LayeredMap_Interact(const LayeredMap* m, int tx, int ty)
 {
-    if (!m || !m->interact) return 0;
-    if (tx < 0 || ty < 0 || tx >= m->width || ty >= m->height) return 0;
-    return m->interact[idx(m, tx, ty)];
+    if (!m || !in_bounds(m, tx, ty)) return 0;
+    if (m->interact) return m->interact[idx(m, tx, ty)];
+    if (m->interact8) return m->interact8[packed_idx(m, tx, ty)];
+    if (m->interact_sparse) return SparseLayer_Get(m->interact_sparse, tx, ty);
+    if (m->stream) return MapStream_Tile(m->stream, MAP_LAYER_INTERACT, tx, ty, 0);
+    return 0;
 }
 
 bool LayeredMap_Solid(const LayeredMap* m, int tx, int ty)
 {
-    if (!m || !m->coll) return false;
-    if (tx < 0 || ty < 0 || tx >= m->width || ty >= m->height) return true; // outside is solid
-    return m->coll[idx(m, tx, ty)] != 0;
+    if (!m || (!m->coll && !m->coll_bits && !m->stream)) return false;
+    if (!in_bounds(m, tx, ty)) return true; // outside is solid
+    if (m->coll) return m->coll[idx(m, tx, ty)] != 0;
+    if (m->coll_bits)
+    {
+        const size_t i = packed_idx(m, tx, ty);
+        return (m->coll_bits[i >> 6] >> (i & 63)) & 1u;
+    }
+    return MapStream_Tile(m->stream, MAP_LAYER_COLL, tx, ty, 1) != 0; // not loaded yet is solid
 }
 
-bool LayeredMap_SolidAtWorld(const LayeredMap* m, float wx, float wy)
+int LayeredMap_Tile(const LayeredMap* m, LayeredMapLayer layer, int tx, int ty)
 {
-    if (!m || m->tile_size <= 0) return true;
-    const int tx = (int)(wx / (float)m->tile_size);
-    const int ty = (int)(wy / (float)m->tile_size);
-    return LayeredMap_Solid(m, tx, ty);
+    switch (layer)
+    {
+    case MAP_LAYER_GROUND:   return LayeredMap_Ground(m, tx, ty);
+    case MAP_LAYER_DECO:     return LayeredMap_Deco(m, tx, ty);
+    case MAP_LAYER_COLL:     return (m && in_bounds(m, tx, ty) && LayeredMap_Solid(m, tx, ty)) ? 1 : 0;
+    case MAP_LAYER_INTERACT: return LayeredMap_Interact(m, tx, ty);
+    default:                 return 0;
+    }
 }
 
-int LayeredMap_InteractAtWorld(const LayeredMap* m, float wx, float wy)
+// Raw write, no tracking; the caller has checked bounds and streaming.
+static bool store_tile(LayeredMap* m, LayeredMapLayer layer, int tx, int ty, int value)
 {
-    if (!m || m->tile_size <= 0) return 0;
-    const int tx = (int)(wx / (float)m->tile_size);
-    const int ty = (int)(wy / (float)m->tile_size);
-    return LayeredMap_Interact(m, tx, ty);
+    const int i = idx(m, tx, ty);
+    const size_t p = packed_idx(m, tx, ty);
+
+    switch (layer)
+    {
+    case MAP_LAYER_GROUND:
+        if (m->ground) { m->ground[i] = value; return true; }
+        if (m->ground16 && (unsigned)value <= 0xFFFFu) { m->ground16[p] = (uint16_t)value; return true; }
+        return false;
+
+    case MAP_LAYER_DECO:
+        if (m->deco) { m->deco[i] = value; return true; }
+        if (m->deco16 && (unsigned)value <= 0xFFFFu) { m->deco16[p] = (uint16_t)value; return true; }
+        if (m->deco_sparse) return SparseLayer_Set(m->deco_sparse, tx, ty, value);
+        return false;
+
+    case MAP_LAYER_COLL:
+        if (m->coll) { m->coll[i] = value; return true; }
+        if (m->coll_bits)
+        {
+            const uint64_t bit = (uint64_t)1 << (p & 63);
+            if (value) m->coll_bits[p >> 6] |= bit;
+            else m->coll_bits[p >> 6] &= ~bit;
+            return true;
+        }
+        return false;
+
+    case MAP_LAYER_INTERACT:
+        if (m->interact) { m->interact[i] = value; return true; }
+        if (m->interact8 && (unsigned)value <= 0xFFu) { m->interact8[p] = (uint8_t)value; return true; }
+        if (m->interact_sparse) return SparseLayer_Set(m->interact_sparse, tx, ty, value);
+        return false;
+
+    default:
+        return false;
+    }
 }
 
-// ---------- File parsing helpers ----------
+bool LayeredMap_ClipRect(const LayeredMap* m, int* tx0, int* ty0, int* tx1, int* ty1)
+{
+    if (!m || !tx0 || !ty0 || !tx1 || !ty1) return false;
+    if (*tx0 < 0) *tx0 = 0;
+    if (*ty0 < 0) *ty0 = 0;
+    if (*tx1 > m->width)  *tx1 = m->width;
+    if (*ty1 > m->height) *ty1 = m->height;
+    return *tx0 < *tx1 && *ty0 < *ty1;
+}
+
+const int* LayeredMap_Row(const LayeredMap* m, LayeredMapLayer layer, int tx0, int ty, int count, int* scratch)
+{
+    if (!m || count <= 0 || (unsigned)layer >= MAP_LAYER_COUNT ||
+        !in_bounds(m, tx0, ty) || tx0 + count > m->width)
+    {
+        if (scratch && count > 0) memset(scratch, 0, sizeof(int) * (size_t)count);
+        return scratch;
+    }
+
+    const int* dense[MAP_LAYER_COUNT] = { m->ground, m->deco, m->coll, m->interact };
+    if (dense[layer] && layer != MAP_LAYER_COLL) return dense[layer] + idx(m, tx0, ty);
+
+    const SparseLayer* sparse = LayeredMap_SparseLayer(m, layer);
+
+    int* out = scratch;
+    if (layer == MAP_LAYER_COLL && m->coll)
+    {
+        const int* src = m->coll + idx(m, tx0, ty);
+        for (int x = 0; x < count; ++x) out[x] = src[x] != 0;
+    }
+    else if (layer == MAP_LAYER_COLL && m->coll_bits)
+    {
+        for (int x = 0; x < count; ++x)
+        {
+            const size_t i = packed_idx(m, tx0 + x, ty);
+            out[x] = (int)((m->coll_bits[i >> 6] >> (i & 63)) & 1u);
+        }
+    }
+    else if (layer == MAP_LAYER_GROUND && m->ground16)
+    {
+        for (int x = 0; x < count; ++x) out[x] = m->ground16[packed_idx(m, tx0 + x, ty)];
+    }
+    else if (layer == MAP_LAYER_DECO && m->deco16)
+    {
+        for (int x = 0; x < count; ++x) out[x] = m->deco16[packed_idx(m, tx0 + x, ty)];
+    }
+    else if (layer == MAP_LAYER_INTERACT && m->interact8)
+    {
+        for (int x = 0; x < count; ++x) out[x] = m->interact8[packed_idx(m, tx0 + x, ty)];
+    }
+    else if (sparse)
+    {
+        memset(out, 0, sizeof(int) * (size_t)count);
+        int first = 0;
+        const int n = SparseLayer_RowRange(sparse, ty, ty + 1, &first);
+        for (int c = first; c < first + n; ++c)
+        {
+            const int x = sparse->cells[c].tx - tx0;
+            if (x >= 0 && x < count) out[x] = sparse->cells[c].value;
+        }
+    }
+    else
+    {
+        for (int x = 0; x < count; ++x) out[x] = LayeredMap_Tile(m, layer, tx0 + x, ty);
+    }
+    return out;
+}
 
-static char* read_entire_file(const char* path, size_t* out_size)
+bool LayeredMap_VisitRect(const LayeredMap* m, LayeredMapLayer layer, int tx0, int ty0, int tx1, int ty1,
+                          LayeredMapRowVisitor visit, void* user)
 {
-    FILE* f = fopen(path, "rb");
-    if (!f) return NULL;
+    if (!visit || !LayeredMap_ClipRect(m, &tx0, &ty0, &tx1, &ty1)) return true;
 
-    fseek(f, 0, SEEK_END);
-    long sz = ftell(f);
-    fseek(f, 0, SEEK_SET);
+    int scratch[LAYERED_MAP_SPAN_MAX];
+    for (int ty = ty0; ty < ty1; ++ty)
+    {
+        for (int x = tx0; x < tx1; x += LAYERED_MAP_SPAN_MAX)
+        {
+            const int count = SDL_min(tx1 - x, LAYERED_MAP_SPAN_MAX);
+            const int* row = LayeredMap_Row(m, layer, x, ty, count, scratch);
+            if (!visit(user, x, ty, row, count)) return false;
+        }
+    }
+    return true;
+}
 
-    if (sz <= 0) { fclose(f); return NULL; }
+int LayeredMap_ApplyDiff(LayeredMap* m, const LayeredMap* next)
+{
+    if (!m || !next || m->stream || next->stream) return -1;
+    if (m->width != next->width || m->height != next->height || m->tile_size != next->tile_size)
+        return -1;
 
-    char* buf = (char*)malloc((size_t)sz + 1);
-    if (!buf) { fclose(f); return NULL; }
+    int* a = (int*)SDL_malloc(sizeof(int) * 2 * (size_t)m->width);
+    if (!a) return -1;
+    int* b = a + m->width;
 
-    size_t rd = fread(buf, 1, (size_t)sz, f);
-    fclose(f);
+    // Compare whole rows first; only differing rows are walked per tile.
+    int changed = 0;
+    for (int layer = 0; layer < MAP_LAYER_COUNT && changed >= 0; ++layer)
+    {
+        for (int ty = 0; ty < m->height && changed >= 0; ++ty)
+        {
+            const int* ra = LayeredMap_Row(m, (LayeredMapLayer)layer, 0, ty, m->width, a);
+            const int* rb = LayeredMap_Row(next, (LayeredMapLayer)layer, 0, ty, m->width, b);
+            if (memcmp(ra, rb, sizeof(int) * (size_t)m->width) == 0) continue;
+
+            for (int tx = 0; tx < m->width; ++tx)
+            {
+                if (ra[tx] == rb[tx]) continue;
+                if (!LayeredMap_SetTile(m, (LayeredMapLayer)layer, tx, ty, rb[tx]))
+                {
+                    changed = -1;
+                    break;
+                }
+                changed++;
+            }
+        }
+    }
 
-    buf[rd] = '\0';
-    if (out_size) *out_size = rd;
-    return buf;
+    SDL_free(a);
+    return changed;
 }
 
-static void str_to_upper(char* s)
+// ---------- Edit tracking ----------
+
+struct LayeredMapTrack
+{
+    int chunks_w;
+    int chunks_h;
+    uint64_t* dirty;        // 1 bit per chunk, row-major
+    size_t dirty_words;
+    size_t dirty_cursor;    // word TakeDirtyChunk resumes from
+
+    uint64_t seq;           // edits so far; edit n lives in journal[n % cap]
+    LayeredMapEdit journal[LAYERED_MAP_JOURNAL_CAP];
+};
+
+static void track_destroy(LayeredMapTrack* t)
 {
-    for (; *s; ++s) *s = (char)toupper((unsigned char)*s);
+    if (!t) return;
+    SDL_free(t->dirty);
+    SDL_free(t);
 }
 
-// returns pointer to next token (modifies buffer by writing '\0')
-static char* next_token(char** cursor)
+static LayeredMapTrack* track_get(LayeredMap* m)
 {
-    char* s = *cursor;
-    while (*s && isspace((unsigned char)*s)) s++;
-    if (!*s) { *cursor = s; return NULL; }
+    if (m->track) return m->track;
 
-    char* start = s;
-    while (*s && !isspace((unsigned char)*s)) s++;
-    if (*s) { *s = '\0'; s++; }
-    *cursor = s;
-    return start;
+    LayeredMapTrack* t = (LayeredMapTrack*)SDL_calloc(1, sizeof(LayeredMapTrack));
+    if (!t) return NULL;
+
+    t->chunks_w = (m->width + LAYERED_MAP_CHUNK - 1) >> LAYERED_MAP_CHUNK_SHIFT;
+    t->chunks_h = (m->height + LAYERED_MAP_CHUNK - 1) >> LAYERED_MAP_CHUNK_SHIFT;
+    t->dirty_words = ((size_t)t->chunks_w * (size_t)t->chunks_h + 63) / 64;
+    t->dirty = (uint64_t*)SDL_calloc(t->dirty_words, sizeof(uint64_t));
+    if (!t->dirty)
+    {
+        SDL_free(t);
+        SDL_Log("LayeredMap: out of memory for edit tracking");
+        return NULL;
+    }
+
+    m->track = t;
+    return t;
 }
 
-static bool token_is(const char* t, const char* word)
+static int lowest_bit(uint64_t v)
 {
-    return t && word && strcmp(t, word) == 0;
+#if defined(__GNUC__)
+    return __builtin_ctzll(v);
+#else
+    int b = 0;
+    while (!(v & 1u)) { v >>= 1; ++b; }
+    return b;
+#endif
 }
 
-static bool read_ints(char** cursor, int* dst, int count)
+static void mark_dirty(LayeredMapTrack* t, int tx, int ty)
 {
-    for (int i = 0; i < count; ++i)
+    const size_t chunk = (size_t)(ty >> LAYERED_MAP_CHUNK_SHIFT) * (size_t)t->chunks_w +
+                         (size_t)(tx >> LAYERED_MAP_CHUNK_SHIFT);
+    t->dirty[chunk >> 6] |= (uint64_t)1 << (chunk & 63);
+}
+
+bool LayeredMap_SetTile(LayeredMap* m, LayeredMapLayer layer, int tx, int ty, int value)
+{
+    if (!m || !in_bounds(m, tx, ty) || m->stream) return false;
+    if ((unsigned)layer >= MAP_LAYER_COUNT) return false;
+    if (layer == MAP_LAYER_COLL) value = value != 0;
+
+    const int old = LayeredMap_Tile(m, layer, tx, ty);
+    if (old == value) return true;
+
+    LayeredMapTrack* t = track_get(m);
+    if (!t || !store_tile(m, layer, tx, ty, value)) return false;
+    if (layer == MAP_LAYER_COLL)
     {
-        char* tok = next_token(cursor);
-        if (!tok) return false;
+        CollTable_Invalidate(m->coll_table, tx, ty);
+        if (m->coll_rects) m->coll_rects->stale = true;
+        if (m->regions && !MapRegions_SetWalkable(m->regions, tx, ty, value == 0))
+        {
+            SDL_Log("LayeredMap_SetTile: out of memory relabeling regions, dropping them");
+            MapRegions_Destroy(m->regions);
+            m->regions = NULL;
+        }
+    }
 
-        // allow commas
-        for (char* p = tok; *p; ++p) if (*p == ',') *p = ' ';
-        dst[i] = atoi(tok);
+    mark_dirty(t, tx, ty);
+    if (layer == MAP_LAYER_DECO && m->autotile)
+    {
+        // Neighbors' variants change too, possibly in the next chunk over
+        Autotile_Update(m->autotile, m, tx, ty);
+        mark_dirty(t, SDL_max(tx - 1, 0), SDL_max(ty - 1, 0));
+        mark_dirty(t, SDL_min(tx + 1, m->width - 1), SDL_max(ty - 1, 0));
+        mark_dirty(t, SDL_max(tx - 1, 0), SDL_min(ty + 1, m->height - 1));
+        mark_dirty(t, SDL_min(tx + 1, m->width - 1), SDL_min(ty + 1, m->height - 1));
+    }
+
+    LayeredMapEdit* e = &t->journal[t->seq % LAYERED_MAP_JOURNAL_CAP];
+    e->tx = tx;
+    e->ty = ty;
+    e->layer = (int)layer;
+    e->old_value = old;
+    e->new_value = value;
+    t->seq++;
+
+    // Solid tile ids carry their collision with them, like apply_tile_props
+    if ((layer == MAP_LAYER_GROUND || layer == MAP_LAYER_DECO) && value != 0)
+    {
+        const TileProps* p = TileProps_Active();
+        if (p && (TileProps_Flags(p, value) & TILE_SOLID))
+            return LayeredMap_SetTile(m, MAP_LAYER_COLL, tx, ty, 1);
     }
     return true;
 }
 
-bool LayeredMap_LoadFromFile(LayeredMap* m, const char* path)
+bool LayeredMap_SetGround(LayeredMap* m, int tx, int ty, int tile_id)
 {
-    if (!m || !path) return false;
+    return LayeredMap_SetTile(m, MAP_LAYER_GROUND, tx, ty, tile_id);
+}
+
+bool LayeredMap_SetDeco(LayeredMap* m, int tx, int ty, int tile_id)
+{
+    return LayeredMap_SetTile(m, MAP_LAYER_DECO, tx, ty, tile_id);
+}
 
-    size_t sz = 0;
-    char* buf = read_entire_file(path, &sz);
-    if (!buf)
+bool LayeredMap_SetSolid(LayeredMap* m, int tx, int ty, bool solid)
+{
+    return LayeredMap_SetTile(m, MAP_LAYER_COLL, tx, ty, solid ? 1 : 0);
+}
+
+bool LayeredMap_SetInteract(LayeredMap* m, int tx, int ty, int id)
+{
+    return LayeredMap_SetTile(m, MAP_LAYER_INTERACT, tx, ty, id);
+}
+
+bool LayeredMap_TakeDirtyChunk(LayeredMap* m, int* cx, int* cy)
+{
+    if (!m || !m->track || !cx || !cy) return false;
+    LayeredMapTrack* t = m->track;
+
+    for (size_t k = 0; k < t->dirty_words; ++k)
     {
-        SDL_Log("LayeredMap_LoadFromFile: cannot read %s", path);
-        return false;
-    }
+        const size_t w = (t->dirty_cursor + k) % t->dirty_words;
+        if (!t->dirty[w]) continue;
 
-    // Tokenize in-place; we uppercase only header tokens by copying.
-    char* cursor = buf;
+        const size_t chunk = w * 64 + (size_t)lowest_bit(t->dirty[w]);
+        t->dirty[w] &= t->dirty[w] - 1;
+        t->dirty_cursor = w;
 
-    // Expect header: MAP3 width height tile_size (but we also tolerate missing MAP3)
-    int width = 0, height = 0, tile_size = 0;
+        *cx = (int)(chunk % (size_t)t->chunks_w);
+        *cy = (int)(chunk / (size_t)t->chunks_w);
+        return true;
+    }
+    return false;
+}
 
-    char* t0 = next_token(&cursor);
-    if (!t0) { free(buf); return false; }
+uint64_t LayeredMap_EditSeq(const LayeredMap* m)
+{
+    return (m && m->track) ? m->track->seq : 0;
+}
 
-    char header[32];
-    SDL_strlcpy(header, t0, sizeof(header));
-    str_to_upper(header);
+int LayeredMap_ReadJournal(const LayeredMap* m, uint64_t* since, LayeredMapEdit* out, int cap)
+{
+    if (!since) return -1;
+    const uint64_t seq = LayeredMap_EditSeq(m);
 
-    if (token_is(header, "MAP3"))
+    if (*since > seq || seq - *since > LAYERED_MAP_JOURNAL_CAP)
     {
-        char* tw = next_token(&cursor);
-        char* th = next_token(&cursor);
-        char* ts2 = next_token(&cursor);
-        if (!tw || !th || !ts2) { free(buf); return false; }
-        width = atoi(tw);
-        height = atoi(th);
-        tile_size = atoi(ts2);
+        *since = seq;
+        return -1;
     }
-    else
+
+    int n = 0;
+    for (; *since < seq && n < cap; ++n, ++*since)
+        out[n] = m->track->journal[*since % LAYERED_MAP_JOURNAL_CAP];
+    return n;
+}
+
+// ---------- Packed storage ----------
+
+#define PACK_ALIGN 64
+
+static size_t pack_align(size_t v)
+{
+    return (v + (PACK_ALIGN - 1)) & ~(size_t)(PACK_ALIGN - 1);
+}
+
+bool LayeredMap_Pack(LayeredMap* m)
+{
+    if (!m || m->stream) return false;
+    if (m->packed) return true;
+    if (!m->ground || !m->coll) return false;
+    if (!m->deco && !m->deco_sparse) return false;
+    if (!m->interact && !m->interact_sparse) return false;
+
+    const size_t n = (size_t)m->width * (size_t)m->height;
+    const size_t cells = packed_cells(m);
+
+    for (size_t i = 0; i < n; ++i)
     {
-        // If file starts with width height tile_size
-        width = atoi(t0);
-        char* th = next_token(&cursor);
-        char* ts2 = next_token(&cursor);
-        if (!th || !ts2) { free(buf); return false; }
-        height = atoi(th);
-        tile_size = atoi(ts2);
+        if ((unsigned)m->ground[i] > 0xFFFFu ||
+            (m->deco && (unsigned)m->deco[i] > 0xFFFFu) ||
+            (m->interact && (unsigned)m->interact[i] > 0xFFu))
+        {
+            SDL_Log("LayeredMap_Pack: tile %zu does not fit packed ranges", i);
+            return false;
+        }
     }
 
-    if (width <= 0 || height <= 0 || tile_size <= 0)
+    // [ground u16][deco u16][interact u8][coll bits u64], each 64-byte aligned;
+    // sparse layers get no section
+    const size_t off_deco  = pack_align(cells * sizeof(uint16_t));
+    const size_t off_inter = off_deco + (m->deco ? pack_align(cells * sizeof(uint16_t)) : 0);
+    const size_t off_coll  = off_inter + (m->interact ? pack_align(cells * sizeof(uint8_t)) : 0);
+    const size_t total     = off_coll + pack_align(((cells + 63) / 64) * sizeof(uint64_t));
+
+    unsigned char* block = (unsigned char*)SDL_aligned_alloc(PACK_ALIGN, total);
+    if (!block) return false;
+    memset(block, 0, total);
+
+    uint16_t* g  = (uint16_t*)(void*)block;
+    uint16_t* d  = m->deco ? (uint16_t*)(void*)(block + off_deco) : NULL;
+    uint8_t*  it = m->interact ? block + off_inter : NULL;
+    uint64_t* cb = (uint64_t*)(void*)(block + off_coll);
+
+    // Int layers are row-major; the packed ones follow packed_idx.
+    for (int ty = 0; ty < m->height; ++ty)
     {
-        SDL_Log("LayeredMap_LoadFromFile: bad dimensions in %s", path);
-        free(buf);
-        return false;
+        for (int tx = 0; tx < m->width; ++tx)
+        {
+            const size_t i = (size_t)idx(m, tx, ty);
+            const size_t p = packed_idx(m, tx, ty);
+            g[p] = (uint16_t)m->ground[i];
+            if (d)  d[p]  = (uint16_t)m->deco[i];
+            if (it) it[p] = (uint8_t)m->interact[i];
+            if (m->coll[i]) cb[p >> 6] |= (uint64_t)1 << (p & 63);
+        }
     }
 
-    LayeredMap_Shutdown(m);
-    if (!LayeredMap_Init(m, width, height, tile_size))
+    // Drop the int layers (heap or mapping), keep dimensions and sparse layers.
+    const int w = m->width, h = m->height, ts = m->tile_size;
+    SparseLayer* deco_sparse = m->deco_sparse;
+    SparseLayer* interact_sparse = m->interact_sparse;
+    m->deco_sparse = m->interact_sparse = NULL;
+    free_layers(m);
+    m->width = w;
+    m->height = h;
+    m->tile_size = ts;
+    m->deco_sparse = deco_sparse;
+    m->interact_sparse = interact_sparse;
+
+    m->packed = block;
+    m->packed_size = total;
+    m->ground16 = g;
+    m->deco16 = d;
+    m->interact8 = it;
+    m->coll_bits = cb;
+    return true;
+}
+
+size_t LayeredMap_MemoryBytes(const LayeredMap* m)
+{
+    if (!m) return 0;
+
+    const size_t n = (size_t)m->width * (size_t)m->height;
+
+    if (m->stream)
     {
-        free(buf);
-        return false;
+        MapStreamStats st;
+        MapStream_GetStats(m->stream, &st);
+        return (size_t)st.budget * MAP_STREAM_CHUNK * MAP_STREAM_CHUNK * MAP_LAYER_COUNT * sizeof(int);
     }
 
-    const int n = width * height;
+    size_t bytes = SparseLayer_MemoryBytes(m->deco_sparse) + SparseLayer_MemoryBytes(m->interact_sparse);
+    if (m->track) bytes += sizeof(LayeredMapTrack) + m->track->dirty_words * sizeof(uint64_t);
+    bytes += CollTable_MemoryBytes(m->coll_table) + CollRects_MemoryBytes(m->coll_rects);
+    bytes += MapRegions_MemoryBytes(m->regions) + Autotile_MemoryBytes(m->autotile);
+    if (m->packed) return bytes + m->packed_size;
+    if (m->backing) return bytes + m->backing_size;
+
+    const int* dense[MAP_LAYER_COUNT] = { m->ground, m->deco, m->coll, m->interact };
+    for (int i = 0; i < MAP_LAYER_COUNT; ++i)
+        if (dense[i]) bytes += n * sizeof(int);
+    return bytes;
+}
 
-    // Read sections
-    bool got_ground = false, got_deco = false, got_coll = false, got_interact = false;
+const SparseLayer* LayeredMap_SparseLayer(const LayeredMap* m, LayeredMapLayer layer)
+{
+    if (!m) return NULL;
+    if (layer == MAP_LAYER_DECO) return m->deco_sparse;
+    if (layer == MAP_LAYER_INTERACT) return m->interact_sparse;
+    return NULL;
+}
+
+// Replace a dense int layer with a sparse one if few enough tiles are set.
+// Mapped layers are just dropped; their pages are never touched again.
+static void sparsify_layer(LayeredMap* m, int** dense, SparseLayer** sparse)
+{
+    if (!*dense) return;
 
-    while (1)
+    const size_t n = (size_t)m->width * (size_t)m->height;
+    const size_t limit = n / LAYERED_MAP_SPARSE_DIVISOR;
+
+    size_t used = 0;
+    for (size_t i = 0; i < n && used <= limit; ++i)
+        if ((*dense)[i] != 0) used++;
+    if (used > limit) return;
+
+    SparseLayer* s = SparseLayer_FromDense(*dense, m->width, m->height);
+    if (!s) return; // keep the dense layer
+
+    if (!m->backing) free(*dense);
+    *dense = NULL;
+    *sparse = s;
+}
+
+// OR the TILE_SOLID property of each tile's ground and deco ids into its
+// collision bit. Runs on freshly parsed (dense) layers.
+static void apply_tile_props(LayeredMap* m, const TileProps* p)
+{
+    if (!p || !m->ground || !m->deco || !m->coll) return;
+
+    const size_t n = (size_t)m->width * (size_t)m->height;
+    for (size_t i = 0; i < n; ++i)
     {
-        char* tok = next_token(&cursor);
-        if (!tok) break;
+        const unsigned f = TileProps_Flags(p, m->ground[i]) | TileProps_Flags(p, m->deco[i]);
+        m->coll[i] |= (int)(f & TILE_SOLID);
+    }
+}
 
-        char key[32];
-        SDL_strlcpy(key, tok, sizeof(key));
-        str_to_upper(key);
+static void select_layer_storage(LayeredMap* m)
+{
+    sparsify_layer(m, &m->deco, &m->deco_sparse);
+    sparsify_layer(m, &m->interact, &m->interact_sparse);
+}
 
-        if (token_is(key, "GROUND"))
-        {
-            got_ground = read_ints(&cursor, m->ground, n);
-        }
-        else if (token_is(key, "DECO"))
-        {
-            got_deco = read_ints(&cursor, m->deco, n);
-        }
-        else if (token_is(key, "COLLISION") || token_is(key, "COLL"))
+// ---------- Rect solidity ----------
+
+bool LayeredMap_BuildCollTable(LayeredMap* m)
+{
+    if (!m || m->stream) return false;
+
+    CollTable* t = CollTable_Build(m);
+    if (!t) return false;
+
+    CollTable_Destroy(m->coll_table);
+    m->coll_table = t;
+    return true;
+}
+
+int LayeredMap_SolidCount(const LayeredMap* m, int tx0, int ty0, int tx1, int ty1)
+{
+    if (tx1 <= tx0 || ty1 <= ty0) return 0;
+
+    const long long area = (long long)(tx1 - tx0) * (long long)(ty1 - ty0);
+    int cx0 = tx0, cy0 = ty0, cx1 = tx1, cy1 = ty1;
+    if (!LayeredMap_ClipRect(m, &cx0, &cy0, &cx1, &cy1)) return (int)SDL_min(area, (long long)SDL_MAX_SINT32);
+
+    long long solid = area - (long long)(cx1 - cx0) * (long long)(cy1 - cy0); // outside part
+    if (m->coll_table)
+    {
+        solid += CollTable_Count(m->coll_table, m, cx0, cy0, cx1, cy1);
+    }
+    else
+    {
+        int buf[LAYERED_MAP_SPAN_MAX];
+        for (int ty = cy0; ty < cy1; ++ty)
         {
-            got_coll = read_ints(&cursor, m->coll, n);
+            for (int x = cx0; x < cx1; x += LAYERED_MAP_SPAN_MAX)
+            {
+                const int count = SDL_min(cx1 - x, LAYERED_MAP_SPAN_MAX);
+                const int* row = LayeredMap_Row(m, MAP_LAYER_COLL, x, ty, count, buf);
+                for (int i = 0; i < count; ++i) solid += row[i];
+            }
         }
-        else if (token_is(key, "INTERACT"))
+    }
+    return (int)SDL_min(solid, (long long)SDL_MAX_SINT32);
+}
+
+bool LayeredMap_RectClear(const LayeredMap* m, int tx0, int ty0, int tx1, int ty1)
+{
+    return LayeredMap_SolidCount(m, tx0, ty0, tx1, ty1) == 0;
+}
+
+// ---------- Collision rects ----------
+
+bool LayeredMap_BakeCollRects(LayeredMap* m)
+{
+    if (!m || m->stream) return false;
+
+    CollRects* c = CollRects_Bake(m);
+    if (!c) return false;
+
+    CollRects_Destroy(m->coll_rects);
+    m->coll_rects = c;
+    return true;
+}
+
+const CollRects* LayeredMap_CollRects(const LayeredMap* m)
+{
+    return (m && m->coll_rects && !m->coll_rects->stale) ? m->coll_rects : NULL;
+}
+
+bool LayeredMap_CollRectsStale(const LayeredMap* m)
+{
+    return m && m->coll_rects && m->coll_rects->stale;
+}
+
+// ---------- Reachability ----------
+
+bool LayeredMap_BuildRegions(LayeredMap* m)
+{
+    if (!m || m->stream) return false;
+
+    MapRegions* r = MapRegions_Build(m);
+    if (!r) return false;
+
+    MapRegions_Destroy(m->regions);
+    m->regions = r;
+    return true;
+}
+
+int LayeredMap_Region(const LayeredMap* m, int tx, int ty)
+{
+    if (!m || !in_bounds(m, tx, ty)) return 0;
+    if (!m->regions) return LayeredMap_Solid(m, tx, ty) ? 0 : 1;
+    return (int)m->regions->labels[idx(m, tx, ty)];
+}
+
+bool LayeredMap_Reachable(const LayeredMap* m, int ax, int ay, int bx, int by)
+{
+    const int a = LayeredMap_Region(m, ax, ay);
+    return a != 0 && a == LayeredMap_Region(m, bx, by);
+}
+
+// ---------- Autotiling ----------
+
+bool LayeredMap_BuildAutotile(LayeredMap* m)
+{
+    if (!m || m->stream) return false;
+
+    const TileProps* props = TileProps_Active();
+    Autotile_Destroy(m->autotile);
+    m->autotile = NULL;
+    if (!props || !props->any_autotile) return true;
+
+    m->autotile = Autotile_Build(m, props);
+    return m->autotile != NULL;
+}
+
+int LayeredMap_DecoShown(const LayeredMap* m, int tx, int ty)
+{
+    const int id = LayeredMap_Deco(m, tx, ty);
+    if (!m || !m->autotile || !in_bounds(m, tx, ty)) return id;
+    return TileProps_AutotileId(m->autotile->props, id, *Autotile_Row(m->autotile, tx, ty));
+}
+
+bool LayeredMap_SolidAtWorld(const LayeredMap* m, float wx, float wy)
+{
+    if (!m || m->tile_size <= 0) return true;
+    const int tx = (int)(wx / (float)m->tile_size);
+    const int ty = (int)(wy / (float)m->tile_size);
+    return LayeredMap_Solid(m, tx, ty);
+}
+
+int LayeredMap_InteractAtWorld(const LayeredMap* m, float wx, float wy)
+{
+    if (!m || m->tile_size <= 0) return 0;
+    const int tx = (int)(wx / (float)m->tile_size);
+    const int ty = (int)(wy / (float)m->tile_size);
+    return LayeredMap_Interact(m, tx, ty);
+}
+
+bool LayeredMap_LoadFromFile(LayeredMap* m, const char* path)
+{
+    if (!m || !path) return false;
+
+    char bin_path[256];
+    if (MapBinary_PathFor(path, bin_path, sizeof(bin_path)) &&
+        MapBinary_IsFresh(path, bin_path))
+    {
+        MapBinaryHeader h;
+        if (MapBinary_ReadHeader(bin_path, &h) &&
+            (long long)h.width * (long long)h.height >= MAP_STREAM_MIN_TILES &&
+            MapStream_Open(m, bin_path, 0))
         {
-            got_interact = read_ints(&cursor, m->interact, n);
+            return true;
         }
-        else
+
+        if (MapBinary_Load(m, bin_path))
         {
-            // Unknown token; ignore.
+            select_layer_storage(m);
+            (void)LayeredMap_BuildCollTable(m);
+            (void)LayeredMap_BakeCollRects(m);
+            (void)LayeredMap_BuildRegions(m);
+            (void)LayeredMap_BuildAutotile(m);
+            return true;
         }
     }
 
-    free(buf);
+    if (!LayeredMap_LoadTextFile(m, path)) return false;
+    (void)LayeredMap_BuildCollTable(m);
+    (void)LayeredMap_BakeCollRects(m);
+    (void)LayeredMap_BuildRegions(m);
+    (void)LayeredMap_BuildAutotile(m);
+    return true;
+}
+
+bool LayeredMap_LoadTextFile(LayeredMap* m, const char* path)
+{
+    if (!m || !path) return false;
 
-    // Missing sections are fine; they default to 0.
-    SDL_Log("Loaded map %s: %dx%d ts=%d sections: ground=%d deco=%d coll=%d interact=%d",
-            path, width, height, tile_size, got_ground, got_deco, got_coll, got_interact);
+    SDL_IOStream* io = SDL_IOFromFile(path, "rb");
+    if (!io)
+    {
+        SDL_Log("LayeredMap_LoadTextFile: cannot read %s", path);
+        return false;
+    }
 
-    return true;
+    const bool ok = MapText_Load(m, io, path);
+    SDL_CloseIO(io);
+    if (ok)
+    {
+        apply_tile_props(m, TileProps_Active());
+        select_layer_storage(m);
+    }
+    return ok;
 }
@@ -1,6 +1,51 @@
 // src/world/layered_map.h
 #pragma once
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct MapStream MapStream;
+typedef struct SparseLayer SparseLayer;
+typedef struct LayeredMapTrack LayeredMapTrack;
+typedef struct CollTable CollTable;
+typedef struct CollRects CollRects;
+typedef struct MapRegions MapRegions;
+typedef struct Autotile Autotile;
+
+// Deco/interact layers with at most 1/N non-zero tiles are stored sparse.
+#define LAYERED_MAP_SPARSE_DIVISOR 64
+
+// Layout of the packed layers. 0 = row-major. 1 = 8x8 tile blocks stored one
+// after another, so a small 2D neighborhood touches a few blocks instead of a
+// cache line per row (a block is one line of interact8 and one coll_bits
+// word). Text, compiled and dense int layers are always row-major; only
+// LayeredMap_Pack reorders. Build with -DLAYERED_MAP_BLOCKED=1 (make LAYOUT=blocked).
+#ifndef LAYERED_MAP_BLOCKED
+#define LAYERED_MAP_BLOCKED 0
+#endif
+#define LAYERED_MAP_BLOCK_SHIFT 3
+
+// Edit tracking: dirty bits per 16x16-tile chunk, journal of recent edits.
+#define LAYERED_MAP_CHUNK_SHIFT 4
+#define LAYERED_MAP_CHUNK       (1 << LAYERED_MAP_CHUNK_SHIFT)
+#define LAYERED_MAP_JOURNAL_CAP 4096
+
+typedef enum LayeredMapLayer
+{
+    MAP_LAYER_GROUND = 0,
+    MAP_LAYER_DECO,
+    MAP_LAYER_COLL,
+    MAP_LAYER_INTERACT,
+    MAP_LAYER_COUNT
+} LayeredMapLayer;
+
+typedef struct LayeredMapEdit
+{
+    int tx, ty;
+    int layer;       // LayeredMapLayer
+    int old_value;
+    int new_value;
+} LayeredMapEdit;
 
 typedef struct LayeredMap
 {
@@ -12,19 +57,193 @@ typedef struct LayeredMap
     int* deco;       // width*height
     int* coll;       // width*height (0/1)
     int* interact;   // width*height (0=none, 1=sign, 2=npc, 3=chest, ...)
+
+    // Set when the layers point into a mapped compiled map (see map_binary.h)
+    void*  backing;
+    size_t backing_size;
+
+    // Set in chunked world mode; the layer arrays are NULL (see map_stream.h)
+    MapStream* stream;
+
+    // Packed mode (LayeredMap_Pack): one block, the int layers are NULL.
+    // Indexed row-major or by 8x8 block (LAYERED_MAP_BLOCKED).
+    void*     packed;
+    uint16_t* ground16;
+    uint16_t* deco16;
+    uint8_t*  interact8;
+    uint64_t* coll_bits;   // 1 bit per tile
+    size_t    packed_size;
+
+    // Mostly-empty layers chosen at load (see sparse_layer.h); the matching
+    // int/packed layer is NULL
+    SparseLayer* deco_sparse;
+    SparseLayer* interact_sparse;
+
+    // Dirty chunks and edit journal; created by the first tile edit
+    LayeredMapTrack* track;
+
+    // Summed-area table of coll for rect queries (see coll_table.h)
+    CollTable* coll_table;
+
+    // Solid tiles merged into rects (see coll_rects.h)
+    CollRects* coll_rects;
+
+    // Connected walkable regions (see map_regions.h)
+    MapRegions* regions;
+
+    // Deco autotile masks (see autotile.h); NULL when no id autotiles
+    Autotile* autotile;
 } LayeredMap;
 
 bool LayeredMap_Init(LayeredMap* m, int width, int height, int tile_size);
 void LayeredMap_Shutdown(LayeredMap* m);
 
+// Loads "path", preferring an up-to-date compiled sibling ("path" + "b").
+// Very large compiled maps are opened in chunked world mode.
 bool LayeredMap_LoadFromFile(LayeredMap* m, const char* path);
 
+// Parse the text MAP3 format only (used by the map compiler). Ground/deco
+// ids marked solid in the active tile properties (see tile_props.h) are
+// folded into the collision layer, so compiled maps carry them too.
+bool LayeredMap_LoadTextFile(LayeredMap* m, const char* path);
+
+// Convert a loaded map to packed storage: uint16 ground/deco, uint8 interact
+// and a collision bitset in one allocation (~5 bytes per tile instead of 16).
+// Layers already stored sparse stay sparse. Fails, leaving the map
+// untouched, if a value does not fit or the map is streamed.
+bool LayeredMap_Pack(LayeredMap* m);
+
+// Bytes held by the layer storage (mapped, packed, dense or resident chunks).
+size_t LayeredMap_MemoryBytes(const LayeredMap* m);
+
+// Sparse storage for MAP_LAYER_DECO / MAP_LAYER_INTERACT, or NULL if that
+// layer is dense. Its cell list holds every non-empty tile in row order.
+const SparseLayer* LayeredMap_SparseLayer(const LayeredMap* m, LayeredMapLayer layer);
+
 // Safe accessors (return 0 if out-of-bounds)
 int  LayeredMap_Ground(const LayeredMap* m, int tx, int ty);
 int  LayeredMap_Deco(const LayeredMap* m, int tx, int ty);
 int  LayeredMap_Interact(const LayeredMap* m, int tx, int ty);
 bool LayeredMap_Solid(const LayeredMap* m, int tx, int ty);
 
+// Any layer by index; collision reads as 0/1, out-of-bounds as 0.
+int  LayeredMap_Tile(const LayeredMap* m, LayeredMapLayer layer, int tx, int ty);
+
+// ---------- Editing ----------
+//
+// Every runtime change to a map goes through these. A write that changes a
+// tile marks its chunk dirty and is appended to the journal, so anything
+// derived from the map can update the touched area instead of rebuilding.
+// Writing the current value does nothing.
+
+// Write one tile in whatever storage the map uses. Fails if out of bounds,
+// the map is streamed, or the value does not fit packed storage. A ground or
+// deco id that is TILE_SOLID in the active tile properties also sets the
+// collision bit (its own journal entry), as parsing does; clearing collision
+// stays explicit.
+bool LayeredMap_SetTile(LayeredMap* m, LayeredMapLayer layer, int tx, int ty, int value);
+
+bool LayeredMap_SetGround(LayeredMap* m, int tx, int ty, int tile_id);
+bool LayeredMap_SetDeco(LayeredMap* m, int tx, int ty, int tile_id);
+bool LayeredMap_SetSolid(LayeredMap* m, int tx, int ty, bool solid);
+bool LayeredMap_SetInteract(LayeredMap* m, int tx, int ty, int id);
+
+// Pop one dirty chunk (chunk coordinates; tiles cx*LAYERED_MAP_CHUNK ..) and
+// clear it. The bits have a single owner (the renderer's chunk cache); other
+// consumers read the journal.
+bool LayeredMap_TakeDirtyChunk(LayeredMap* m, int* cx, int* cy);
+
+// Number of edits made to this map so far.
+uint64_t LayeredMap_EditSeq(const LayeredMap* m);
+
+// Copy up to "cap" edits made after *since into "out", oldest first, and
+// advance *since past them. Returns the count, or -1 if some were already
+// overwritten in the journal or *since is from another map; rebuild from
+// the map then (*since is set to the current sequence).
+int LayeredMap_ReadJournal(const LayeredMap* m, uint64_t* since, LayeredMapEdit* out, int cap);
+
+// ---------- Row spans ----------
+//
+// Hot loops over a tile rect clip it once and read whole rows, paying the
+// null/bounds checks and storage dispatch per row instead of per tile.
+
+#define LAYERED_MAP_SPAN_MAX 256   // longest row handed to a visitor at once
+
+// Clip the half-open rect [*tx0,*tx1) x [*ty0,*ty1) to the map. False if
+// nothing is left.
+bool LayeredMap_ClipRect(const LayeredMap* m, int* tx0, int* ty0, int* tx1, int* ty1);
+
+// Tiles [tx0, tx0+count) of row ty, which must lie inside the map. Returns a
+// pointer into dense int storage when there is one, otherwise decodes into
+// "scratch" (count ints) and returns that. Collision reads as 0/1.
+const int* LayeredMap_Row(const LayeredMap* m, LayeredMapLayer layer, int tx0, int ty, int count, int* scratch);
+
+// Called per row of a visited rect, with row[i] the tile at (tx0 + i, ty).
+// Return false to stop.
+typedef bool (*LayeredMapRowVisitor)(void* user, int tx0, int ty, const int* row, int count);
+
+// Visit the clipped rect [tx0,tx1) x [ty0,ty1) top to bottom. Rows longer
+// than LAYERED_MAP_SPAN_MAX arrive in pieces. Returns false if the visitor
+// stopped early.
+bool LayeredMap_VisitRect(const LayeredMap* m, LayeredMapLayer layer, int tx0, int ty0, int tx1, int ty1,
+                          LayeredMapRowVisitor visit, void* user);
+
+// Copy every tile of "next" that differs into "m" in place (hot reload).
+// Returns the number of tiles changed, or -1 if the maps differ in size or a
+// tile could not be stored; "m" may then be partly updated.
+int  LayeredMap_ApplyDiff(LayeredMap* m, const LayeredMap* next);
+
+// ---------- Rect solidity ----------
+//
+// Backed by a summed-area table of the collision layer (~4 bytes per tile),
+// these answer in constant time whatever the rect size. LayeredMap_LoadFromFile
+// builds it for non-streamed maps; edits keep it current. Without a table the
+// rect is scanned row by row.
+
+bool LayeredMap_BuildCollTable(LayeredMap* m);
+
+// Solid tiles in [tx0,tx1) x [ty0,ty1); tiles outside the map count as solid.
+int  LayeredMap_SolidCount(const LayeredMap* m, int tx0, int ty0, int tx1, int ty1);
+
+// No solid tile in [tx0,tx1) x [ty0,ty1) and the rect lies inside the map.
+bool LayeredMap_RectClear(const LayeredMap* m, int tx0, int ty0, int tx1, int ty1);
+
+// ---------- Collision rects ----------
+//
+// LayeredMap_LoadFromFile bakes the merged solid rects of non-streamed maps.
+// A collision edit marks them stale: LayeredMap_CollRects then returns NULL
+// (callers fall back to tiles) until the next bake.
+
+bool LayeredMap_BakeCollRects(LayeredMap* m);
+const CollRects* LayeredMap_CollRects(const LayeredMap* m);
+bool LayeredMap_CollRectsStale(const LayeredMap* m);
+
+// ---------- Reachability ----------
+//
+// LayeredMap_LoadFromFile labels the connected walkable regions of
+// non-streamed maps (~4 bytes per tile); collision edits relabel only what
+// they connect or cut off. Without labels (streamed maps) every walkable
+// tile counts as region 1, so Reachable only rules out solid tiles.
+
+bool LayeredMap_BuildRegions(LayeredMap* m);
+
+// Region of tile (tx, ty); 0 for solid or outside tiles.
+int  LayeredMap_Region(const LayeredMap* m, int tx, int ty);
+
+// Whether a walker can get from tile A to tile B, moving between 4-neighbors.
+bool LayeredMap_Reachable(const LayeredMap* m, int ax, int ay, int bx, int by);
+
+// ---------- Autotiling ----------
+//
+// LayeredMap_LoadFromFile computes the deco autotile masks of non-streamed
+// maps when the active tile properties declare autotiled ids; deco edits
+// recompute the 3x3 block around them and mark its chunks dirty.
+
+bool LayeredMap_BuildAutotile(LayeredMap* m);
+
+// Deco id to draw at (tx, ty): the autotile variant, or the stored id.
+int  LayeredMap_DecoShown(const LayeredMap* m, int tx, int ty);
+
 // World-space query (pixels)
 bool LayeredMap_SolidAtWorld(const LayeredMap* m, float wx, float wy);
 int  LayeredMap_InteractAtWorld(const LayeredMap* m, float wx, float wy);
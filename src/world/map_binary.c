@@ -0,0 +1,280 @@
+// src/world/map_binary.c
+#define _POSIX_C_SOURCE 200809L
+
+#include "map_binary.h"
+#include "layered_map.h"
+#include "tile_props.h"
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <malloc.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+_Static_assert(sizeof(MapBinaryHeader) == 64, "MapBinaryHeader must stay 64 bytes");
+_Static_assert(sizeof(int) == sizeof(int32_t), "layers are mapped as int32 blobs");
+
+static uint64_t align_up(uint64_t v, uint64_t a)
+{
+    return (v + (a - 1)) & ~(a - 1);
+}
+
+bool MapBinary_PathFor(const char* text_path, char* out, size_t out_cap)
+{
+    if (!text_path || !out || out_cap == 0) return false;
+    const int n = SDL_snprintf(out, out_cap, "%sb", text_path);
+    return n > 0 && (size_t)n < out_cap;
+}
+
+bool MapBinary_IsFresh(const char* text_path, const char* bin_path)
+{
+    SDL_PathInfo bin, txt;
+    if (!SDL_GetPathInfo(bin_path, &bin)) return false;
+    if (!SDL_GetPathInfo(text_path, &txt)) return true; // shipped without source
+    if (bin.modify_time < txt.modify_time) return false;
+
+    // Solid tile properties are folded into the compiled collision layer
+    SDL_PathInfo props;
+    return !SDL_GetPathInfo(TILE_PROPS_DEFAULT_PATH, &props) || bin.modify_time >= props.modify_time;
+}
+
+// ---------- Mapping ----------
+
+static void* map_file(const char* path, size_t* out_size)
+{
+#if defined(_WIN32)
+    // No mmap here; read into an aligned block so the layer pointers are the same.
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+
+    fseek(f, 0, SEEK_END);
+    long sz = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (sz <= 0) { fclose(f); return NULL; }
+
+    void* base = _aligned_malloc((size_t)sz, MAP_BINARY_ALIGN);
+    if (!base) { fclose(f); return NULL; }
+
+    if (fread(base, 1, (size_t)sz, f) != (size_t)sz)
+    {
+        fclose(f);
+        _aligned_free(base);
+        return NULL;
+    }
+    fclose(f);
+
+    *out_size = (size_t)sz;
+    return base;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return NULL;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        close(fd);
+        return NULL;
+    }
+
+    // Private + writable: reads share the page cache, a write only copies the
+    // touched page, so later edits to the live map never reach the file.
+    void* base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) return NULL;
+
+    *out_size = (size_t)st.st_size;
+    return base;
+#endif
+}
+
+void MapBinary_Unmap(void* base, size_t size)
+{
+    if (!base) return;
+#if defined(_WIN32)
+    (void)size;
+    _aligned_free(base);
+#else
+    munmap(base, size);
+#endif
+}
+
+// ---------- Load ----------
+
+static bool validate_header(const MapBinaryHeader* h, uint64_t file_size, const char* path)
+{
+    if (file_size < sizeof(*h) || memcmp(h->magic, MAP_BINARY_MAGIC, sizeof(h->magic)) != 0)
+    {
+        SDL_Log("MapBinary: %s is not a compiled map", path);
+        return false;
+    }
+
+    if (h->version != MAP_BINARY_VERSION || h->byte_order != MAP_BINARY_BYTE_ORDER ||
+        h->layer_count != MAP_BINARY_LAYERS)
+    {
+        SDL_Log("MapBinary: %s has version %u / byte order %08x, expected %u / %08x",
+                path, h->version, h->byte_order, MAP_BINARY_VERSION, MAP_BINARY_BYTE_ORDER);
+        return false;
+    }
+
+    if (h->width <= 0 || h->height <= 0 || h->tile_size <= 0)
+    {
+        SDL_Log("MapBinary: bad dimensions in %s", path);
+        return false;
+    }
+
+    const uint64_t layer_bytes = (uint64_t)h->width * (uint64_t)h->height * sizeof(int32_t);
+    for (int i = 0; i < MAP_BINARY_LAYERS; ++i)
+    {
+        const uint64_t off = h->layer_offset[i];
+        if ((off % MAP_BINARY_ALIGN) != 0 || off < sizeof(*h) || off + layer_bytes > file_size)
+        {
+            SDL_Log("MapBinary: layer %d out of range in %s", i, path);
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MapBinary_ReadHeader(const char* bin_path, MapBinaryHeader* out)
+{
+    if (!bin_path || !out) return false;
+
+    SDL_IOStream* io = SDL_IOFromFile(bin_path, "rb");
+    if (!io) return false;
+
+    const Sint64 size = SDL_GetIOSize(io);
+    const bool ok = size > 0 &&
+                    SDL_ReadIO(io, out, sizeof(*out)) == sizeof(*out) &&
+                    validate_header(out, (uint64_t)size, bin_path);
+    SDL_CloseIO(io);
+    return ok;
+}
+
+bool MapBinary_Load(LayeredMap* m, const char* bin_path)
+{
+    if (!m || !bin_path) return false;
+
+    size_t size = 0;
+    void* base = map_file(bin_path, &size);
+    if (!base) return false;
+
+    const MapBinaryHeader* h = (const MapBinaryHeader*)base;
+    if (!validate_header(h, size, bin_path))
+    {
+        MapBinary_Unmap(base, size);
+        return false;
+    }
+
+    LayeredMap_Shutdown(m);
+    m->width = h->width;
+    m->height = h->height;
+    m->tile_size = h->tile_size;
+
+    unsigned char* bytes = (unsigned char*)base;
+    m->ground   = (int*)(void*)(bytes + h->layer_offset[0]);
+    m->deco     = (int*)(void*)(bytes + h->layer_offset[1]);
+    m->coll     = (int*)(void*)(bytes + h->layer_offset[2]);
+    m->interact = (int*)(void*)(bytes + h->layer_offset[3]);
+
+    m->backing = base;
+    m->backing_size = size;
+
+    SDL_Log("Mapped compiled map %s: %dx%d ts=%d (%zu bytes)",
+            bin_path, m->width, m->height, m->tile_size, size);
+    return true;
+}
+
+// ---------- Write ----------
+
+static bool write_padding(FILE* f, uint64_t from, uint64_t to)
+{
+    static const unsigned char zeros[MAP_BINARY_ALIGN] = { 0 };
+    while (from < to)
+    {
+        const size_t n = (size_t)((to - from) < MAP_BINARY_ALIGN ? (to - from) : MAP_BINARY_ALIGN);
+        if (fwrite(zeros, 1, n, f) != n) return false;
+        from += n;
+    }
+    return true;
+}
+
+// Layers not held as int arrays (packed or sparse) are expanded a row at a time.
+static bool write_layer_rows(FILE* f, const LayeredMap* m, int layer)
+{
+    int32_t* row = (int32_t*)SDL_malloc(sizeof(int32_t) * (size_t)m->width);
+    if (!row) return false;
+
+    bool ok = true;
+    for (int ty = 0; ok && ty < m->height; ++ty)
+    {
+        for (int tx = 0; tx < m->width; ++tx)
+            row[tx] = LayeredMap_Tile(m, (LayeredMapLayer)layer, tx, ty);
+        ok = fwrite(row, sizeof(int32_t), (size_t)m->width, f) == (size_t)m->width;
+    }
+
+    SDL_free(row);
+    return ok;
+}
+
+bool MapBinary_Write(const LayeredMap* m, const char* bin_path)
+{
+    if (!m || !bin_path || m->stream || m->width <= 0 || m->height <= 0) return false;
+
+    const int* layers[MAP_BINARY_LAYERS] = { m->ground, m->deco, m->coll, m->interact };
+    const uint64_t layer_bytes = (uint64_t)m->width * (uint64_t)m->height * sizeof(int32_t);
+
+    MapBinaryHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, MAP_BINARY_MAGIC, sizeof(h.magic));
+    h.version = MAP_BINARY_VERSION;
+    h.byte_order = MAP_BINARY_BYTE_ORDER;
+    h.width = m->width;
+    h.height = m->height;
+    h.tile_size = m->tile_size;
+    h.layer_count = MAP_BINARY_LAYERS;
+
+    uint64_t off = align_up(sizeof(h), MAP_BINARY_ALIGN);
+    for (int i = 0; i < MAP_BINARY_LAYERS; ++i)
+    {
+        h.layer_offset[i] = off;
+        off = align_up(off + layer_bytes, MAP_BINARY_ALIGN);
+    }
+
+    FILE* f = fopen(bin_path, "wb");
+    if (!f)
+    {
+        SDL_Log("MapBinary_Write: cannot open %s", bin_path);
+        return false;
+    }
+
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1;
+    uint64_t pos = sizeof(h);
+
+    for (int i = 0; ok && i < MAP_BINARY_LAYERS; ++i)
+    {
+        ok = write_padding(f, pos, h.layer_offset[i]);
+        if (layers[i])
+            ok = ok && fwrite(layers[i], 1, (size_t)layer_bytes, f) == (size_t)layer_bytes;
+        else
+            ok = ok && write_layer_rows(f, m, i);
+        pos = h.layer_offset[i] + layer_bytes;
+    }
+    ok = ok && write_padding(f, pos, align_up(pos, MAP_BINARY_ALIGN));
+
+    if (fclose(f) != 0) ok = false;
+
+    if (!ok)
+    {
+        SDL_Log("MapBinary_Write: write failed for %s", bin_path);
+        remove(bin_path);
+    }
+    return ok;
+}
@@ -0,0 +1,58 @@
+// src/world/map_binary.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct LayeredMap LayeredMap;
+
+// Compiled map format (.map3b)
+//
+// Layout on disk (little-endian):
+//   [MapBinaryHeader]            64 bytes
+//   [layer 0 blob] ground        int32 * width*height, 64-byte aligned
+//   [layer 1 blob] deco
+//   [layer 2 blob] coll
+//   [layer 3 blob] interact
+//
+// Layer blobs are stored exactly as LayeredMap keeps them in memory, so the
+// loader maps the file and points the layers at it without copying.
+
+#define MAP_BINARY_MAGIC      "MAP3BIN"   // 7 chars + '\0'
+#define MAP_BINARY_VERSION    1u
+#define MAP_BINARY_ALIGN      64u
+#define MAP_BINARY_LAYERS     4
+#define MAP_BINARY_BYTE_ORDER 0x01020304u
+
+typedef struct MapBinaryHeader
+{
+    char     magic[8];
+    uint32_t version;
+    uint32_t byte_order;     // MAP_BINARY_BYTE_ORDER as written by the host
+    int32_t  width;
+    int32_t  height;
+    int32_t  tile_size;
+    uint32_t layer_count;    // MAP_BINARY_LAYERS
+    uint64_t layer_offset[MAP_BINARY_LAYERS]; // from start of file
+} MapBinaryHeader;
+
+// "foo.map3" -> "foo.map3b". Returns false if the result does not fit.
+bool MapBinary_PathFor(const char* text_path, char* out, size_t out_cap);
+
+// True if a compiled sibling exists and is at least as new as the text map
+// and the tile property file (TILE_PROPS_DEFAULT_PATH), whose solid ids it
+// has baked into collision.
+bool MapBinary_IsFresh(const char* text_path, const char* bin_path);
+
+// Read and validate just the header (dimensions and layer offsets).
+bool MapBinary_ReadHeader(const char* bin_path, MapBinaryHeader* out);
+
+// Load a compiled map. On success the layers point into a private
+// copy-on-write mapping owned by the map (released by LayeredMap_Shutdown).
+bool MapBinary_Load(LayeredMap* m, const char* bin_path);
+
+// Write a loaded map out in compiled form (any storage but streamed).
+bool MapBinary_Write(const LayeredMap* m, const char* bin_path);
+
+// Release a mapping created by MapBinary_Load.
+void MapBinary_Unmap(void* base, size_t size);
@@ -0,0 +1,181 @@
+// src/world/map_cache.c
+#include "map_cache.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+typedef struct MapCacheEntry
+{
+    bool       used;
+    char       path[256];
+    LayeredMap map;
+    size_t     bytes;
+    Uint64     last_use;
+} MapCacheEntry;
+
+struct MapCache
+{
+    MapCacheEntry entries[MAP_CACHE_MAX_ENTRIES];
+    size_t bytes;
+    size_t budget;
+    Uint64 clock;
+
+    unsigned hits;
+    unsigned misses;
+    unsigned evictions;
+};
+
+static int find_entry(const MapCache* c, const char* path)
+{
+    for (int i = 0; i < MAP_CACHE_MAX_ENTRIES; ++i)
+        if (c->entries[i].used && SDL_strcmp(c->entries[i].path, path) == 0) return i;
+    return -1;
+}
+
+static void free_entry(MapCache* c, MapCacheEntry* e)
+{
+    LayeredMap_Shutdown(&e->map);
+    c->bytes -= e->bytes;
+    e->used = false;
+    e->bytes = 0;
+}
+
+static int find_lru(const MapCache* c)
+{
+    int lru = -1;
+    for (int i = 0; i < MAP_CACHE_MAX_ENTRIES; ++i)
+    {
+        if (!c->entries[i].used) continue;
+        if (lru < 0 || c->entries[i].last_use < c->entries[lru].last_use) lru = i;
+    }
+    return lru;
+}
+
+// Evict until "extra" more bytes fit.
+static void evict_for(MapCache* c, size_t extra)
+{
+    while (c->bytes + extra > c->budget)
+    {
+        const int lru = find_lru(c);
+        if (lru < 0) break;
+        free_entry(c, &c->entries[lru]);
+        c->evictions++;
+    }
+}
+
+MapCache* MapCache_Create(size_t budget_bytes)
+{
+    MapCache* c = (MapCache*)SDL_calloc(1, sizeof(MapCache));
+    if (!c) return NULL;
+    c->budget = budget_bytes;
+    return c;
+}
+
+void MapCache_Destroy(MapCache* c)
+{
+    if (!c) return;
+    for (int i = 0; i < MAP_CACHE_MAX_ENTRIES; ++i)
+        if (c->entries[i].used) free_entry(c, &c->entries[i]);
+    SDL_free(c);
+}
+
+void MapCache_SetBudget(MapCache* c, size_t budget_bytes)
+{
+    if (!c) return;
+    c->budget = budget_bytes;
+    evict_for(c, 0);
+}
+
+void MapCache_Put(MapCache* c, const char* path, LayeredMap* m)
+{
+    if (!m) return;
+    if (!c || !path || !path[0] || m->width <= 0)
+    {
+        LayeredMap_Shutdown(m);
+        return;
+    }
+
+    const int old = find_entry(c, path);
+    if (old >= 0) free_entry(c, &c->entries[old]);
+
+    const size_t bytes = LayeredMap_MemoryBytes(m);
+    if (bytes > c->budget)
+    {
+        LayeredMap_Shutdown(m);
+        c->evictions++;
+        return;
+    }
+
+    evict_for(c, bytes);
+
+    int slot = -1;
+    for (int i = 0; i < MAP_CACHE_MAX_ENTRIES && slot < 0; ++i)
+        if (!c->entries[i].used) slot = i;
+    if (slot < 0)
+    {
+        slot = find_lru(c);
+        free_entry(c, &c->entries[slot]);
+        c->evictions++;
+    }
+
+    MapCacheEntry* e = &c->entries[slot];
+    e->used = true;
+    SDL_strlcpy(e->path, path, sizeof(e->path));
+    e->map = *m;
+    e->bytes = bytes;
+    e->last_use = ++c->clock;
+    c->bytes += bytes;
+
+    memset(m, 0, sizeof(*m));
+}
+
+bool MapCache_Take(MapCache* c, const char* path, LayeredMap* out)
+{
+    if (!c || !path || !out) return false;
+
+    const int i = find_entry(c, path);
+    if (i < 0)
+    {
+        c->misses++;
+        return false;
+    }
+
+    MapCacheEntry* e = &c->entries[i];
+    *out = e->map;
+    memset(&e->map, 0, sizeof(e->map));
+    c->bytes -= e->bytes;
+    e->used = false;
+    e->bytes = 0;
+
+    c->hits++;
+    return true;
+}
+
+void MapCache_Drop(MapCache* c, const char* path)
+{
+    if (!c || !path) return;
+
+    const int i = find_entry(c, path);
+    if (i >= 0) free_entry(c, &c->entries[i]);
+}
+
+bool MapCache_Contains(const MapCache* c, const char* path)
+{
+    return c && path && find_entry(c, path) >= 0;
+}
+
+void MapCache_GetStats(const MapCache* c, MapCacheStats* out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!c) return;
+
+    out->hits = c->hits;
+    out->misses = c->misses;
+    out->evictions = c->evictions;
+    out->bytes = c->bytes;
+    out->budget = c->budget;
+    for (int i = 0; i < MAP_CACHE_MAX_ENTRIES; ++i)
+        if (c->entries[i].used) out->count++;
+}
@@ -0,0 +1,49 @@
+// src/world/map_cache.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct LayeredMap LayeredMap;
+typedef struct MapCache MapCache;
+
+// LRU cache of loaded maps, keyed by path
+//
+// Maps move in and out of the cache by value: Put takes ownership of a map
+// the game is leaving, Take hands it back when the game returns. The sum of
+// LayeredMap_MemoryBytes over cached maps stays within the budget; the least
+// recently used maps are freed first. Main thread only.
+
+#define MAP_CACHE_MAX_ENTRIES    16
+#define MAP_CACHE_DEFAULT_BUDGET ((size_t)64 * 1024 * 1024)
+
+typedef struct MapCacheStats
+{
+    unsigned hits;
+    unsigned misses;
+    unsigned evictions;
+    int      count;     // maps currently cached
+    size_t   bytes;     // their LayeredMap_MemoryBytes total
+    size_t   budget;
+} MapCacheStats;
+
+MapCache* MapCache_Create(size_t budget_bytes);
+void MapCache_Destroy(MapCache* c);
+
+// Lowering the budget evicts immediately.
+void MapCache_SetBudget(MapCache* c, size_t budget_bytes);
+
+// Store *m under "path" and zero *m. Replaces an older entry for the same
+// path. A map larger than the whole budget is freed instead.
+void MapCache_Put(MapCache* c, const char* path, LayeredMap* m);
+
+// Move the cached map for "path" into *out (must be empty). Counts a hit or
+// a miss.
+bool MapCache_Take(MapCache* c, const char* path, LayeredMap* out);
+
+// Free the cached copy of "path", if any (e.g. the file changed on disk).
+void MapCache_Drop(MapCache* c, const char* path);
+
+// Lookup without counting or touching LRU order.
+bool MapCache_Contains(const MapCache* c, const char* path);
+
+void MapCache_GetStats(const MapCache* c, MapCacheStats* out);
@@ -0,0 +1,307 @@
+// src/world/map_gen.c
+#include "map_gen.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+// Salts keep the random streams of different features apart
+enum
+{
+    SALT_NOISE = 1,
+    SALT_ROCK,
+    SALT_ROOM,
+    SALT_ROOM_W,
+    SALT_ROOM_H,
+    SALT_ROOM_X,
+    SALT_ROOM_Y,
+    SALT_CHEST
+};
+
+#define GEN_OCTAVES 3
+
+typedef struct GenRoom
+{
+    bool exists;
+    bool chest;
+    int x, y, w, h;   // outer rect, walls included
+} GenRoom;
+
+typedef struct GenJob
+{
+    LayeredMap* m;
+    const MapGenParams* p;
+    const GenRoom* rooms;
+    int cells_w;
+    int cells_h;
+    int jobs_w;
+    int job_count;
+    SDL_AtomicInt next;
+} GenJob;
+
+static uint32_t hash_xy(uint32_t seed, int x, int y, uint32_t salt)
+{
+    uint32_t h = seed ^ (salt * 0x9E3779B9u);
+    h ^= (uint32_t)x * 0x85EBCA6Bu;
+    h = (h ^ (h >> 15)) * 0x2C1B3C6Du;
+    h ^= (uint32_t)y * 0xC2B2AE35u;
+    h = (h ^ (h >> 13)) * 0x297A2D39u;
+    return h ^ (h >> 16);
+}
+
+static float unit(uint32_t h)
+{
+    return (float)(h >> 8) * (1.0f / 16777216.0f);
+}
+
+static float noise(const MapGenParams* p, int x, int y)
+{
+    float sum = 0.0f, amp = 1.0f, total = 0.0f;
+    for (int o = 0; o < GEN_OCTAVES; ++o)
+    {
+        const int s = SDL_max(p->noise_scale >> o, 2);
+        const int ix = x / s, iy = y / s;
+        float fx = (float)(x - ix * s) / (float)s;
+        float fy = (float)(y - iy * s) / (float)s;
+        fx = fx * fx * (3.0f - 2.0f * fx);
+        fy = fy * fy * (3.0f - 2.0f * fy);
+
+        const uint32_t salt = SALT_NOISE + 16u * (uint32_t)o;
+        const float a = unit(hash_xy(p->seed, ix, iy, salt));
+        const float b = unit(hash_xy(p->seed, ix + 1, iy, salt));
+        const float c = unit(hash_xy(p->seed, ix, iy + 1, salt));
+        const float d = unit(hash_xy(p->seed, ix + 1, iy + 1, salt));
+        const float top = a + (b - a) * fx;
+        const float bottom = c + (d - c) * fx;
+
+        sum += (top + (bottom - top) * fy) * amp;
+        total += amp;
+        amp *= 0.5f;
+    }
+    return sum / total;
+}
+
+static void set_tile(LayeredMap* m, int x, int y, int ground, int deco, int coll)
+{
+    const size_t i = (size_t)y * (size_t)m->width + (size_t)x;
+    m->ground[i] = ground;
+    m->deco[i] = deco;
+    m->coll[i] = coll;
+}
+
+static void layout_rooms(const MapGenParams* p, GenRoom* rooms, int cells_w, int cells_h)
+{
+    for (int cy = 0; cy < cells_h; ++cy)
+    {
+        for (int cx = 0; cx < cells_w; ++cx)
+        {
+            GenRoom* r = &rooms[cy * cells_w + cx];
+            memset(r, 0, sizeof(*r));
+
+            // One free row/column per cell keeps neighboring rooms apart
+            const int bx = cx * p->room_cell, by = cy * p->room_cell;
+            const int aw = SDL_min(p->room_cell, p->width - bx) - 1;
+            const int ah = SDL_min(p->room_cell, p->height - by) - 1;
+            if (aw < p->room_min || ah < p->room_min) continue;
+            if (hash_xy(p->seed, cx, cy, SALT_ROOM) % 100u >= (uint32_t)p->room_chance) continue;
+
+            r->exists = true;
+            r->w = p->room_min + (int)(hash_xy(p->seed, cx, cy, SALT_ROOM_W) % (uint32_t)(aw - p->room_min + 1));
+            r->h = p->room_min + (int)(hash_xy(p->seed, cx, cy, SALT_ROOM_H) % (uint32_t)(ah - p->room_min + 1));
+            r->x = bx + (int)(hash_xy(p->seed, cx, cy, SALT_ROOM_X) % (uint32_t)(aw - r->w + 1));
+            r->y = by + (int)(hash_xy(p->seed, cx, cy, SALT_ROOM_Y) % (uint32_t)(ah - r->h + 1));
+            r->chest = hash_xy(p->seed, cx, cy, SALT_CHEST) % 100u < (uint32_t)p->chest_chance;
+        }
+    }
+}
+
+// Walls, floor, a door in the bottom wall and maybe a chest, clipped to
+// [x0,x1) x [y0,y1).
+static void draw_room(LayeredMap* m, const MapGenParams* p, const GenRoom* r, int x0, int y0, int x1, int y1)
+{
+    const int rx0 = SDL_max(r->x, x0), rx1 = SDL_min(r->x + r->w, x1);
+    const int ry0 = SDL_max(r->y, y0), ry1 = SDL_min(r->y + r->h, y1);
+    const int door_x = r->x + r->w / 2;
+
+    for (int y = ry0; y < ry1; ++y)
+    {
+        for (int x = rx0; x < rx1; ++x)
+        {
+            const bool edge = x == r->x || y == r->y || x == r->x + r->w - 1 || y == r->y + r->h - 1;
+            const bool door = x == door_x && y == r->y + r->h - 1;
+            if (edge && !door) set_tile(m, x, y, p->floor_id, p->wall_id, 1);
+            else set_tile(m, x, y, p->floor_id, 0, 0);
+            m->interact[(size_t)y * (size_t)m->width + (size_t)x] = 0;
+        }
+    }
+
+    const int chest_x = r->x + 1, chest_y = r->y + 1;
+    if (r->chest && chest_x >= x0 && chest_x < x1 && chest_y >= y0 && chest_y < y1)
+        m->interact[(size_t)chest_y * (size_t)m->width + (size_t)chest_x] = 3;
+}
+
+// Carve floor along [ax,bx] x [ay,by] (either order), clipped.
+static void carve(LayeredMap* m, const MapGenParams* p, int ax, int ay, int bx, int by, int x0, int y0, int x1, int y1)
+{
+    const int cx0 = SDL_max(SDL_min(ax, bx), x0), cx1 = SDL_min(SDL_max(ax, bx) + 1, x1);
+    const int cy0 = SDL_max(SDL_min(ay, by), y0), cy1 = SDL_min(SDL_max(ay, by) + 1, y1);
+    for (int y = cy0; y < cy1; ++y)
+        for (int x = cx0; x < cx1; ++x)
+            set_tile(m, x, y, p->floor_id, 0, 0);
+}
+
+// L-shaped corridors from each room to the rooms of the next cell right and
+// below. A corridor stays inside the two cells it joins.
+static void draw_corridors(const GenJob* j, const GenRoom* a, int cx, int cy, int x0, int y0, int x1, int y1)
+{
+    const int ax = a->x + a->w / 2, ay = a->y + a->h / 2;
+
+    if (cx + 1 < j->cells_w)
+    {
+        const GenRoom* b = &j->rooms[cy * j->cells_w + cx + 1];
+        if (b->exists)
+        {
+            const int bx = b->x + b->w / 2, by = b->y + b->h / 2;
+            carve(j->m, j->p, ax, ay, bx, ay, x0, y0, x1, y1);
+            carve(j->m, j->p, bx, ay, bx, by, x0, y0, x1, y1);
+        }
+    }
+    if (cy + 1 < j->cells_h)
+    {
+        const GenRoom* b = &j->rooms[(cy + 1) * j->cells_w + cx];
+        if (b->exists)
+        {
+            const int bx = b->x + b->w / 2, by = b->y + b->h / 2;
+            carve(j->m, j->p, ax, ay, ax, by, x0, y0, x1, y1);
+            carve(j->m, j->p, ax, by, bx, by, x0, y0, x1, y1);
+        }
+    }
+}
+
+static void run_job(GenJob* j, int job)
+{
+    LayeredMap* m = j->m;
+    const MapGenParams* p = j->p;
+    const int x0 = (job % j->jobs_w) * MAP_GEN_JOB, y0 = (job / j->jobs_w) * MAP_GEN_JOB;
+    const int x1 = SDL_min(x0 + MAP_GEN_JOB, m->width), y1 = SDL_min(y0 + MAP_GEN_JOB, m->height);
+
+    // Terrain and rocks
+    for (int y = y0; y < y1; ++y)
+    {
+        for (int x = x0; x < x1; ++x)
+        {
+            const float n = noise(p, x, y);
+            if (n < p->water_level)
+            {
+                set_tile(m, x, y, p->water_id, 0, 1);
+                continue;
+            }
+            const int ground = n > p->stone_level ? p->stone_id : p->grass_id;
+            const bool rock = (hash_xy(p->seed, x, y, SALT_ROCK) & 1023u) < (uint32_t)p->scatter_per_1024;
+            set_tile(m, x, y, ground, rock ? p->rock_id : 0, rock);
+        }
+    }
+
+    // Rooms, then corridors (which cut the doorways). Corridors of the
+    // cells left of / above the job can reach into it.
+    const int c = p->room_cell;
+    const int cx0 = x0 / c, cy0 = y0 / c;
+    const int cx1 = SDL_min((x1 - 1) / c, j->cells_w - 1), cy1 = SDL_min((y1 - 1) / c, j->cells_h - 1);
+
+    for (int cy = cy0; cy <= cy1; ++cy)
+        for (int cx = cx0; cx <= cx1; ++cx)
+            if (j->rooms[cy * j->cells_w + cx].exists)
+                draw_room(m, p, &j->rooms[cy * j->cells_w + cx], x0, y0, x1, y1);
+
+    for (int cy = SDL_max(cy0 - 1, 0); cy <= cy1; ++cy)
+        for (int cx = SDL_max(cx0 - 1, 0); cx <= cx1; ++cx)
+            if (j->rooms[cy * j->cells_w + cx].exists)
+                draw_corridors(j, &j->rooms[cy * j->cells_w + cx], cx, cy, x0, y0, x1, y1);
+}
+
+static int gen_worker(void* user)
+{
+    GenJob* j = (GenJob*)user;
+    for (;;)
+    {
+        const int job = SDL_AddAtomicInt(&j->next, 1);
+        if (job >= j->job_count) break;
+        run_job(j, job);
+    }
+    return 0;
+}
+
+void MapGen_DefaultParams(MapGenParams* p, uint32_t seed, int width, int height)
+{
+    if (!p) return;
+    memset(p, 0, sizeof(*p));
+
+    p->seed = seed;
+    p->width = width;
+    p->height = height;
+    p->tile_size = 32;
+
+    p->noise_scale = 48;
+    p->water_level = 0.30f;
+    p->stone_level = 0.68f;
+
+    p->room_cell = 24;
+    p->room_chance = 45;
+    p->room_min = 6;
+    p->chest_chance = 25;
+
+    p->scatter_per_1024 = 8;
+
+    p->grass_id = 4;
+    p->stone_id = 1;
+    p->water_id = 3;
+    p->floor_id = 1;
+    p->wall_id = 3;
+    p->rock_id = 2;
+}
+
+bool MapGen_Generate(LayeredMap* m, const MapGenParams* p, int threads)
+{
+    if (!m || !p || p->room_cell < 4 || p->room_min < 3 || p->noise_scale < 1) return false;
+    if (!LayeredMap_Init(m, p->width, p->height, p->tile_size))
+    {
+        SDL_Log("MapGen_Generate: cannot allocate %dx%d", p->width, p->height);
+        return false;
+    }
+
+    GenJob j;
+    memset(&j, 0, sizeof(j));
+    j.m = m;
+    j.p = p;
+    j.cells_w = (p->width + p->room_cell - 1) / p->room_cell;
+    j.cells_h = (p->height + p->room_cell - 1) / p->room_cell;
+    j.jobs_w = (p->width + MAP_GEN_JOB - 1) / MAP_GEN_JOB;
+    j.job_count = j.jobs_w * ((p->height + MAP_GEN_JOB - 1) / MAP_GEN_JOB);
+
+    GenRoom* rooms = (GenRoom*)SDL_malloc(sizeof(GenRoom) * (size_t)j.cells_w * (size_t)j.cells_h);
+    if (!rooms)
+    {
+        LayeredMap_Shutdown(m);
+        return false;
+    }
+    layout_rooms(p, rooms, j.cells_w, j.cells_h);
+    j.rooms = rooms;
+
+    if (threads <= 0) threads = SDL_GetNumLogicalCPUCores();
+    threads = SDL_clamp(threads, 1, SDL_min(MAP_GEN_MAX_THREADS, j.job_count));
+
+    // The calling thread works too; a worker that fails to start just
+    // leaves more jobs for the others.
+    SDL_Thread* workers[MAP_GEN_MAX_THREADS];
+    int started = 0;
+    for (int i = 1; i < threads; ++i)
+    {
+        workers[started] = SDL_CreateThread(gen_worker, "MapGen", &j);
+        if (workers[started]) started++;
+    }
+    gen_worker(&j);
+    for (int i = 0; i < started; ++i) SDL_WaitThread(workers[i], NULL);
+
+    SDL_free(rooms);
+    return true;
+}
@@ -0,0 +1,52 @@
+// src/world/map_gen.h
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct LayeredMap LayeredMap;
+
+// Seeded procedural maps
+//
+// Value-noise terrain (grass, stone, water), walled rooms on a coarse grid
+// joined to their right/lower neighbors by corridors, and scattered rocks.
+// Every tile is a pure function of the parameters and its position (rooms
+// are laid out up front, random draws hash the coordinates), so the map is
+// filled in MAP_GEN_JOB-square pieces on worker threads and comes out the
+// same whatever the thread count.
+
+#define MAP_GEN_JOB         64   // tiles per side of one work item
+#define MAP_GEN_MAX_THREADS 64
+
+typedef struct MapGenParams
+{
+    uint32_t seed;
+    int width;
+    int height;
+    int tile_size;
+
+    // Terrain: coarsest noise octave spans noise_scale tiles
+    int   noise_scale;
+    float water_level;         // noise below: water (solid)
+    float stone_level;         // noise above: stone ground
+
+    // Rooms: at most one per room_cell x room_cell cell
+    int room_cell;
+    int room_chance;           // percent of cells with a room
+    int room_min;              // smallest side, walls included
+    int chest_chance;          // percent of rooms with a chest (interact 3)
+
+    int scatter_per_1024;      // rocks per 1024 open tiles
+
+    // Tile ids; defaults match assets/tiles/tileset.png
+    int grass_id;
+    int stone_id;
+    int water_id;
+    int floor_id;
+    int wall_id;
+    int rock_id;
+} MapGenParams;
+
+void MapGen_DefaultParams(MapGenParams* p, uint32_t seed, int width, int height);
+
+// Fill *m (must be empty) with dense layers. threads <= 0 uses every core.
+bool MapGen_Generate(LayeredMap* m, const MapGenParams* p, int threads);
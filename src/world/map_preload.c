@@ -0,0 +1,165 @@
+// src/world/map_preload.c
+#include "map_preload.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#define PRELOAD_PATH_MAX 256
+
+struct MapPreload
+{
+    SDL_Thread* thread;
+    SDL_Mutex* lock;
+    SDL_Condition* wake;
+    bool quit;
+
+    // All below guarded by lock
+    char path[PRELOAD_PATH_MAX];   // current request ("" = none)
+    bool pending;                  // worker has not picked "path" up yet
+    MapPreloadState state;
+    LayeredMap result;             // valid when state == MAP_PRELOAD_READY
+};
+
+static void drop_result(MapPreload* p)
+{
+    if (p->state == MAP_PRELOAD_READY)
+        LayeredMap_Shutdown(&p->result);
+}
+
+static int preload_main(void* user)
+{
+    MapPreload* p = (MapPreload*)user;
+    char path[PRELOAD_PATH_MAX];
+
+    SDL_LockMutex(p->lock);
+    for (;;)
+    {
+        while (!p->quit && !p->pending)
+            SDL_WaitCondition(p->wake, p->lock);
+        if (p->quit) break;
+
+        SDL_strlcpy(path, p->path, sizeof(path));
+        p->pending = false;
+        SDL_UnlockMutex(p->lock);
+
+        LayeredMap m;
+        memset(&m, 0, sizeof(m));
+        const Uint64 t0 = SDL_GetTicksNS();
+        bool ok = LayeredMap_LoadFromFile(&m, path);
+        if (ok) (void)LayeredMap_Pack(&m);
+        const Uint64 t1 = SDL_GetTicksNS();
+
+        SDL_LockMutex(p->lock);
+        if (!p->pending && SDL_strcmp(p->path, path) == 0)
+        {
+            if (ok) p->result = m;
+            p->state = ok ? MAP_PRELOAD_READY : MAP_PRELOAD_FAILED;
+            SDL_Log("Preloaded map %s in %.2f ms", path, (double)(t1 - t0) / 1e6);
+        }
+        else if (ok)
+        {
+            // Superseded while loading
+            LayeredMap_Shutdown(&m);
+        }
+    }
+    SDL_UnlockMutex(p->lock);
+    return 0;
+}
+
+MapPreload* MapPreload_Create(void)
+{
+    MapPreload* p = (MapPreload*)SDL_calloc(1, sizeof(MapPreload));
+    if (!p) return NULL;
+
+    p->lock = SDL_CreateMutex();
+    p->wake = SDL_CreateCondition();
+    if (p->lock && p->wake)
+        p->thread = SDL_CreateThread(preload_main, "MapPreload", p);
+
+    if (!p->thread)
+    {
+        SDL_Log("MapPreload_Create: setup failed: %s", SDL_GetError());
+        MapPreload_Destroy(p);
+        return NULL;
+    }
+    return p;
+}
+
+void MapPreload_Destroy(MapPreload* p)
+{
+    if (!p) return;
+
+    if (p->thread)
+    {
+        SDL_LockMutex(p->lock);
+        p->quit = true;
+        SDL_SignalCondition(p->wake);
+        SDL_UnlockMutex(p->lock);
+        SDL_WaitThread(p->thread, NULL);
+    }
+
+    drop_result(p);
+    if (p->wake) SDL_DestroyCondition(p->wake);
+    if (p->lock) SDL_DestroyMutex(p->lock);
+    SDL_free(p);
+}
+
+void MapPreload_Request(MapPreload* p, const char* path)
+{
+    if (!p || !path || !path[0]) return;
+
+    SDL_LockMutex(p->lock);
+    if (SDL_strcmp(p->path, path) != 0 || p->state == MAP_PRELOAD_IDLE)
+    {
+        drop_result(p);
+        SDL_strlcpy(p->path, path, sizeof(p->path));
+        p->pending = true;
+        p->state = MAP_PRELOAD_LOADING;
+        SDL_SignalCondition(p->wake);
+    }
+    SDL_UnlockMutex(p->lock);
+}
+
+void MapPreload_Invalidate(MapPreload* p, const char* path)
+{
+    if (!p || !path) return;
+
+    SDL_LockMutex(p->lock);
+    if (SDL_strcmp(p->path, path) == 0 && p->state != MAP_PRELOAD_IDLE)
+    {
+        drop_result(p);
+        p->pending = true;
+        p->state = MAP_PRELOAD_LOADING;
+        SDL_SignalCondition(p->wake);
+    }
+    SDL_UnlockMutex(p->lock);
+}
+
+MapPreloadState MapPreload_State(MapPreload* p, const char* path)
+{
+    if (!p || !path) return MAP_PRELOAD_IDLE;
+
+    SDL_LockMutex(p->lock);
+    const MapPreloadState st = (SDL_strcmp(p->path, path) == 0) ? p->state : MAP_PRELOAD_IDLE;
+    SDL_UnlockMutex(p->lock);
+    return st;
+}
+
+bool MapPreload_Take(MapPreload* p, const char* path, LayeredMap* out)
+{
+    if (!p || !path || !out) return false;
+
+    bool ok = false;
+    SDL_LockMutex(p->lock);
+    if (p->state == MAP_PRELOAD_READY && SDL_strcmp(p->path, path) == 0)
+    {
+        *out = p->result;
+        memset(&p->result, 0, sizeof(p->result));
+        p->path[0] = '\0';
+        p->state = MAP_PRELOAD_IDLE;
+        ok = true;
+    }
+    SDL_UnlockMutex(p->lock);
+    return ok;
+}
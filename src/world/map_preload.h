@@ -0,0 +1,38 @@
+// src/world/map_preload.h
+#pragma once
+#include <stdbool.h>
+
+typedef struct LayeredMap LayeredMap;
+typedef struct MapPreload MapPreload;
+
+// Background map loading
+//
+// One worker thread loads (and packs) a requested map into a private
+// LayeredMap. The main thread polls the request and, once it is ready, takes
+// the prepared map in one step; it never waits on file I/O or parsing.
+// Only the latest request is kept: asking for a different path drops the
+// previous result (or discards it when the in-flight load finishes).
+
+typedef enum MapPreloadState
+{
+    MAP_PRELOAD_IDLE = 0,   // nothing requested for this path
+    MAP_PRELOAD_LOADING,
+    MAP_PRELOAD_READY,
+    MAP_PRELOAD_FAILED
+} MapPreloadState;
+
+MapPreload* MapPreload_Create(void);
+void MapPreload_Destroy(MapPreload* p);
+
+// Start loading "path" unless it is already loading or ready. Cheap to call
+// every update.
+void MapPreload_Request(MapPreload* p, const char* path);
+
+// "path" changed on disk: a finished or in-flight load of it is redone.
+void MapPreload_Invalidate(MapPreload* p, const char* path);
+
+MapPreloadState MapPreload_State(MapPreload* p, const char* path);
+
+// If "path" is ready, move the prepared map into *out (which must be empty,
+// e.g. after LayeredMap_Shutdown) and return true. Clears the request.
+bool MapPreload_Take(MapPreload* p, const char* path, LayeredMap* out);
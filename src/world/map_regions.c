@@ -0,0 +1,342 @@
+// src/world/map_regions.c
+#include "map_regions.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#define REGION_GROUPS MAP_REGIONS_SEARCHES
+#define REGION_TEMP   0xFFFFFFF0u   // temp labels during a split search, one per group
+
+// sizes[] doubles as the free list: an unused label holds -(next free label).
+
+static int alloc_label(MapRegions* r)
+{
+    if (r->free_head)
+    {
+        const int l = r->free_head;
+        r->free_head = -r->sizes[l];
+        r->sizes[l] = 0;
+        r->regions++;
+        return l;
+    }
+
+    if (r->label_count >= r->capacity)
+    {
+        if (r->capacity > SDL_MAX_SINT32 / 4) return 0;
+        const int cap = r->capacity ? r->capacity * 2 : 64;
+        int* sizes = (int*)SDL_realloc(r->sizes, sizeof(int) * (size_t)cap);
+        if (!sizes) return 0;
+        r->sizes = sizes;
+        r->capacity = cap;
+    }
+
+    const int l = r->label_count++;
+    r->sizes[l] = 0;
+    r->regions++;
+    return l;
+}
+
+static void free_label(MapRegions* r, int l)
+{
+    r->sizes[l] = -r->free_head;
+    r->free_head = l;
+    r->regions--;
+}
+
+static bool push(MapRegions* r, int q, int tile)
+{
+    if (r->queue_len[q] == r->queue_cap[q])
+    {
+        const int cap = r->queue_cap[q] ? r->queue_cap[q] * 2 : 256;
+        int* items = (int*)SDL_realloc(r->queue[q], sizeof(int) * (size_t)cap);
+        if (!items) return false;
+        r->queue[q] = items;
+        r->queue_cap[q] = cap;
+    }
+    r->queue[q][r->queue_len[q]++] = tile;
+    return true;
+}
+
+// 4-neighbors of "tile" inside the map, written to out; returns the count.
+static int neighbors(const MapRegions* r, int tile, int out[4])
+{
+    const int x = tile % r->width, y = tile / r->width;
+    int n = 0;
+    if (y > 0) out[n++] = tile - r->width;
+    if (x < r->width - 1) out[n++] = tile + 1;
+    if (y < r->height - 1) out[n++] = tile + r->width;
+    if (x > 0) out[n++] = tile - 1;
+    return n;
+}
+
+// Give every tile labeled "from" that is connected to "seed" the label "to";
+// returns how many changed. -1 if out of memory.
+static int relabel(MapRegions* r, int seed, uint32_t from, uint32_t to)
+{
+    r->queue_len[0] = 0;
+    r->labels[seed] = to;
+    if (!push(r, 0, seed)) return -1;
+
+    int count = 1;
+    while (r->queue_len[0] > 0)
+    {
+        const int tile = r->queue[0][--r->queue_len[0]];
+        int nb[4];
+        const int n = neighbors(r, tile, nb);
+        for (int k = 0; k < n; ++k)
+        {
+            if (r->labels[nb[k]] != from) continue;
+            r->labels[nb[k]] = to;
+            if (!push(r, 0, nb[k])) return -1;
+            count++;
+        }
+    }
+    return count;
+}
+
+MapRegions* MapRegions_Build(const LayeredMap* m)
+{
+    if (!m || m->width <= 0 || m->height <= 0 || m->stream) return NULL;
+
+    MapRegions* r = (MapRegions*)SDL_calloc(1, sizeof(MapRegions));
+    if (!r) return NULL;
+
+    r->width = m->width;
+    r->height = m->height;
+    r->label_count = 1;   // 0 = solid
+    r->labels = (uint32_t*)SDL_malloc(sizeof(uint32_t) * (size_t)m->width * (size_t)m->height);
+    if (!r->labels) goto fail;
+
+    int buf[LAYERED_MAP_SPAN_MAX];
+    for (int ty = 0; ty < m->height; ++ty)
+    {
+        uint32_t* out = r->labels + (size_t)ty * (size_t)m->width;
+        for (int x = 0; x < m->width; x += LAYERED_MAP_SPAN_MAX)
+        {
+            const int count = SDL_min(m->width - x, LAYERED_MAP_SPAN_MAX);
+            const int* solid = LayeredMap_Row(m, MAP_LAYER_COLL, x, ty, count, buf);
+            for (int i = 0; i < count; ++i) out[x + i] = solid[i] ? 0u : REGION_TEMP;
+        }
+    }
+
+    const int n = m->width * m->height;
+    for (int i = 0; i < n; ++i)
+    {
+        if (r->labels[i] != REGION_TEMP) continue;
+
+        const int l = alloc_label(r);
+        const int count = l ? relabel(r, i, REGION_TEMP, (uint32_t)l) : -1;
+        if (count < 0) goto fail;
+        r->sizes[l] = count;
+    }
+
+    // A full-map flood can grow the stack to megabytes; edits need far less
+    SDL_free(r->queue[0]);
+    r->queue[0] = NULL;
+    r->queue_cap[0] = 0;
+    return r;
+
+fail:
+    SDL_Log("MapRegions_Build: out of memory for %dx%d", m->width, m->height);
+    MapRegions_Destroy(r);
+    return NULL;
+}
+
+void MapRegions_Destroy(MapRegions* r)
+{
+    if (!r) return;
+    SDL_free(r->labels);
+    SDL_free(r->sizes);
+    for (int q = 0; q < REGION_GROUPS; ++q) SDL_free(r->queue[q]);
+    SDL_free(r);
+}
+
+// Tile became walkable: join it to its neighbors' regions, folding the
+// smaller ones into the largest.
+static bool open_tile(MapRegions* r, int tile)
+{
+    int nb[4];
+    const int n = neighbors(r, tile, nb);
+
+    int target = 0;
+    for (int k = 0; k < n; ++k)
+    {
+        const int l = (int)r->labels[nb[k]];
+        if (l && (!target || r->sizes[l] > r->sizes[target])) target = l;
+    }
+
+    if (!target)
+    {
+        target = alloc_label(r);
+        if (!target) return false;
+    }
+    r->labels[tile] = (uint32_t)target;
+    r->sizes[target]++;
+
+    for (int k = 0; k < n; ++k)
+    {
+        const int l = (int)r->labels[nb[k]];
+        if (!l || l == target) continue;
+
+        const int moved = relabel(r, nb[k], (uint32_t)l, (uint32_t)target);
+        if (moved < 0) return false;
+        r->sizes[target] += moved;
+        free_label(r, l);
+    }
+    return true;
+}
+
+static int class_of(const int* parent, int g)
+{
+    while (parent[g] != g) g = parent[g];
+    return g;
+}
+
+// Tile became solid: its region may have split. Search outward from the
+// neighbors on different sides in lockstep; a search that runs dry before
+// meeting another has enclosed a new region. Work is bounded by the smaller
+// side(s) of the cut, not the size of the region.
+static bool close_tile(MapRegions* r, int tile)
+{
+    const int w = r->width;
+    const int x = tile % w, y = tile / w;
+    const uint32_t L = r->labels[tile];
+
+    r->labels[tile] = 0;
+    if (--r->sizes[L] == 0)
+    {
+        free_label(r, (int)L);
+        return true;
+    }
+
+    // Ring of 8 around the tile, clockwise from north; even slots are the
+    // 4-neighbors. Neighbors on one walkable arc of the ring stay connected.
+    static const int ring_dx[8] = { 0, 1, 1, 1, 0, -1, -1, -1 };
+    static const int ring_dy[8] = { -1, -1, 0, 1, 1, 1, 0, -1 };
+    bool open[8];
+    int start = -1;
+    for (int s = 0; s < 8; ++s)
+    {
+        const int rx = x + ring_dx[s], ry = y + ring_dy[s];
+        open[s] = rx >= 0 && ry >= 0 && rx < w && ry < r->height && r->labels[ry * w + rx] != 0;
+        if (!open[s] && start < 0) start = s;
+    }
+    if (start < 0) return true;   // ring fully open
+
+    int seeds[REGION_GROUPS];
+    int groups = 0;
+    bool new_arc = true;
+    for (int k = 1; k <= 8; ++k)
+    {
+        const int s = (start + k) & 7;
+        if (!open[s]) { new_arc = true; continue; }
+        if ((s & 1) == 0 && new_arc)
+        {
+            seeds[groups++] = (y + ring_dy[s]) * w + (x + ring_dx[s]);
+            new_arc = false;
+        }
+    }
+    if (groups <= 1) return true;
+
+    int parent[REGION_GROUPS];
+    int head[REGION_GROUPS] = { 0 };
+    for (int g = 0; g < groups; ++g)
+    {
+        parent[g] = g;
+        r->queue_len[g] = 0;
+        r->labels[seeds[g]] = REGION_TEMP + (uint32_t)g;
+        if (!push(r, g, seeds[g])) return false;
+    }
+
+    int classes = groups;
+    for (;;)
+    {
+        int live = 0;
+        bool live_class[REGION_GROUPS] = { false };
+        for (int g = 0; g < groups; ++g)
+        {
+            if (head[g] >= r->queue_len[g]) continue;
+            const int c = class_of(parent, g);
+            if (!live_class[c]) { live_class[c] = true; live++; }
+        }
+        if (classes == 1 || live <= 1) break;
+
+        for (int g = 0; g < groups; ++g)
+        {
+            if (head[g] >= r->queue_len[g]) continue;
+
+            int nb[4];
+            const int n = neighbors(r, r->queue[g][head[g]++], nb);
+            for (int k = 0; k < n; ++k)
+            {
+                const uint32_t l = r->labels[nb[k]];
+                if (l == L)
+                {
+                    r->labels[nb[k]] = REGION_TEMP + (uint32_t)g;
+                    if (!push(r, g, nb[k])) return false;
+                }
+                else if (l >= REGION_TEMP && l != REGION_TEMP + (uint32_t)g)
+                {
+                    const int a = class_of(parent, g), b = class_of(parent, (int)(l - REGION_TEMP));
+                    if (a != b) { parent[b] = a; classes--; }
+                }
+            }
+        }
+    }
+
+    // The class still searching (or, if all ran dry, the largest) keeps L;
+    // every other class is a region of its own.
+    int count[REGION_GROUPS] = { 0 };
+    int keep = -1;
+    for (int g = 0; g < groups; ++g)
+    {
+        const int c = class_of(parent, g);
+        count[c] += r->queue_len[g];
+        if (head[g] < r->queue_len[g]) keep = c;
+    }
+    if (keep < 0)
+    {
+        for (int g = 0; g < groups; ++g)
+            if (parent[g] == g && (keep < 0 || count[g] > count[keep])) keep = g;
+    }
+
+    int label[REGION_GROUPS];
+    for (int g = 0; g < groups; ++g)
+    {
+        if (parent[g] != g) continue;
+        label[g] = (int)L;
+        if (g == keep) continue;
+
+        label[g] = alloc_label(r);
+        if (!label[g]) return false;
+        r->sizes[label[g]] = count[g];
+        r->sizes[L] -= count[g];
+    }
+
+    for (int g = 0; g < groups; ++g)
+    {
+        const uint32_t l = (uint32_t)label[class_of(parent, g)];
+        for (int i = 0; i < r->queue_len[g]; ++i) r->labels[r->queue[g][i]] = l;
+    }
+    return true;
+}
+
+bool MapRegions_SetWalkable(MapRegions* r, int tx, int ty, bool walkable)
+{
+    if (!r || tx < 0 || ty < 0 || tx >= r->width || ty >= r->height) return false;
+
+    const int tile = ty * r->width + tx;
+    if ((r->labels[tile] != 0) == walkable) return true;
+    return walkable ? open_tile(r, tile) : close_tile(r, tile);
+}
+
+size_t MapRegions_MemoryBytes(const MapRegions* r)
+{
+    if (!r) return 0;
+
+    size_t bytes = sizeof(MapRegions) + sizeof(uint32_t) * (size_t)r->width * (size_t)r->height;
+    bytes += sizeof(int) * (size_t)r->capacity;
+    for (int q = 0; q < REGION_GROUPS; ++q) bytes += sizeof(int) * (size_t)r->queue_cap[q];
+    return bytes;
+}
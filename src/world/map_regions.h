@@ -0,0 +1,46 @@
+// src/world/map_regions.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct LayeredMap LayeredMap;
+
+// A closed tile splits its region at most 4 ways
+#define MAP_REGIONS_SEARCHES 4
+
+// Connected regions of walkable tiles.
+//
+// Every walkable tile carries the label of its 4-connected region (0 for
+// solid tiles), so "can A reach B at all" is one comparison. Edits update
+// the labels in place: opening a tile merges the regions around it by
+// relabeling the smaller ones; closing one searches outward from its
+// neighbors in lockstep and relabels only the part that was cut off.
+
+typedef struct MapRegions
+{
+    int width;
+    int height;
+
+    uint32_t* labels;    // width * height, 0 = solid
+    int* sizes;          // tiles per label; <= 0 = unused (free list link)
+    int label_count;     // labels handed out so far (label 0 included)
+    int capacity;        // entries in sizes
+    int free_head;       // first unused label below label_count, 0 = none
+    int regions;         // labels currently in use
+
+    // Search queues for incremental updates
+    int* queue[MAP_REGIONS_SEARCHES];
+    int queue_len[MAP_REGIONS_SEARCHES];
+    int queue_cap[MAP_REGIONS_SEARCHES];
+} MapRegions;
+
+// Label the map's collision layer (any storage). NULL on failure.
+MapRegions* MapRegions_Build(const LayeredMap* m);
+void MapRegions_Destroy(MapRegions* r);
+
+// Tile (tx, ty) became walkable or solid. False only if out of memory, in
+// which case the labels are no longer reliable (rebuild).
+bool MapRegions_SetWalkable(MapRegions* r, int tx, int ty, bool walkable);
+
+size_t MapRegions_MemoryBytes(const MapRegions* r);
@@ -0,0 +1,429 @@
+// src/world/map_stream.c
+#include "map_stream.h"
+#include "layered_map.h"
+#include "map_binary.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#define CHUNK_TILES  (MAP_STREAM_CHUNK * MAP_STREAM_CHUNK)
+#define CHUNK_MASK   (MAP_STREAM_CHUNK - 1)
+#define CHUNK_LAYERS MAP_LAYER_COUNT
+
+// How far ahead (seconds of travel) to request chunks along the velocity.
+#define LOOKAHEAD_SEC 0.75f
+
+// Loader handshake; residency itself is tracked by the main thread.
+typedef enum ChunkState
+{
+    CHUNK_IDLE = 0,
+    CHUNK_QUEUED,   // waiting for / being read by the loader
+    CHUNK_READY,    // read, not yet published by the main thread
+    CHUNK_FAILED    // read failed; the main thread frees the slot to retry later
+} ChunkState;
+
+typedef struct MapChunk
+{
+    int cx, cy;
+    ChunkState state;   // under MapStream.lock
+    bool in_use;        // main thread only: holds a chunk (in the lookup table)
+    bool resident;      // main thread only: readable through MapStream_Tile
+    Uint64 last_used;   // main thread only: Update tick that last wanted it
+    int* data;          // CHUNK_LAYERS * CHUNK_TILES
+} MapChunk;
+
+struct MapStream
+{
+    int width, height;          // tiles
+    int chunks_w, chunks_h;
+    Uint64 layer_offset[CHUNK_LAYERS];
+
+    int max_chunks;
+    MapChunk* slots;
+    int* pool;                  // chunk data for all slots, one block
+    int* table;                 // open addressing: slot index or -1
+    int table_mask;
+    int last_slot;              // one-entry lookup cache for MapStream_Tile
+
+    Uint64 tick;
+    bool primed;
+
+    // Loader thread
+    SDL_IOStream* io;           // loader thread only
+    SDL_Thread* thread;
+    SDL_Mutex* lock;
+    SDL_Condition* wake;        // queue not empty / quit
+    SDL_Condition* done;        // a chunk became READY
+    int* queue;                 // ring of slot indices
+    int q_head, q_count;
+    bool quit;
+
+    unsigned loads, evictions, misses;
+};
+
+// ---------- Lookup table (main thread) ----------
+
+static int hash_chunk(const MapStream* s, int cx, int cy)
+{
+    const unsigned h = (unsigned)cx * 73856093u ^ (unsigned)cy * 19349663u;
+    return (int)(h & (unsigned)s->table_mask);
+}
+
+static int table_find(const MapStream* s, int cx, int cy)
+{
+    for (int i = hash_chunk(s, cx, cy);; i = (i + 1) & s->table_mask)
+    {
+        const int slot = s->table[i];
+        if (slot < 0) return -1;
+        if (s->slots[slot].cx == cx && s->slots[slot].cy == cy) return slot;
+    }
+}
+
+static void table_insert(MapStream* s, int slot)
+{
+    int i = hash_chunk(s, s->slots[slot].cx, s->slots[slot].cy);
+    while (s->table[i] >= 0) i = (i + 1) & s->table_mask;
+    s->table[i] = slot;
+}
+
+static void table_rebuild(MapStream* s)
+{
+    for (int i = 0; i <= s->table_mask; ++i) s->table[i] = -1;
+    for (int i = 0; i < s->max_chunks; ++i)
+        if (s->slots[i].in_use) table_insert(s, i);
+}
+
+// ---------- Loader thread ----------
+
+// False if any row could not be read; the chunk must not be published then.
+static bool read_chunk(MapStream* s, MapChunk* c)
+{
+    const int x0 = c->cx * MAP_STREAM_CHUNK;
+    const int y0 = c->cy * MAP_STREAM_CHUNK;
+    const int cols = SDL_min(MAP_STREAM_CHUNK, s->width - x0);
+    const int rows = SDL_min(MAP_STREAM_CHUNK, s->height - y0);
+
+    memset(c->data, 0, sizeof(int) * CHUNK_LAYERS * CHUNK_TILES);
+
+    for (int l = 0; l < CHUNK_LAYERS; ++l)
+    {
+        int* dst = c->data + l * CHUNK_TILES;
+        for (int r = 0; r < rows; ++r)
+        {
+            const Uint64 off = s->layer_offset[l] +
+                ((Uint64)(y0 + r) * (Uint64)s->width + (Uint64)x0) * sizeof(int);
+            const size_t bytes = (size_t)cols * sizeof(int);
+
+            if (SDL_SeekIO(s->io, (Sint64)off, SDL_IO_SEEK_SET) < 0 ||
+                SDL_ReadIO(s->io, dst + r * MAP_STREAM_CHUNK, bytes) != bytes)
+            {
+                SDL_Log("MapStream: read failed for chunk %d,%d", c->cx, c->cy);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static int loader_main(void* user)
+{
+    MapStream* s = (MapStream*)user;
+
+    SDL_LockMutex(s->lock);
+    for (;;)
+    {
+        while (!s->quit && s->q_count == 0)
+            SDL_WaitCondition(s->wake, s->lock);
+        if (s->quit) break;
+
+        const int slot = s->queue[s->q_head];
+        s->q_head = (s->q_head + 1) % s->max_chunks;
+        s->q_count--;
+        SDL_UnlockMutex(s->lock);
+
+        // A QUEUED slot is never touched by the main thread, so read unlocked.
+        const bool ok = read_chunk(s, &s->slots[slot]);
+
+        SDL_LockMutex(s->lock);
+        s->slots[slot].state = ok ? CHUNK_READY : CHUNK_FAILED;
+        if (ok) s->loads++;
+        SDL_BroadcastCondition(s->done);
+    }
+    SDL_UnlockMutex(s->lock);
+    return 0;
+}
+
+// ---------- Open / close ----------
+
+bool MapStream_Open(LayeredMap* m, const char* bin_path, int max_chunks)
+{
+    if (!m || !bin_path) return false;
+    if (max_chunks <= 0) max_chunks = MAP_STREAM_DEFAULT_CHUNKS;
+
+    MapBinaryHeader h;
+    if (!MapBinary_ReadHeader(bin_path, &h)) return false;
+
+    MapStream* s = (MapStream*)SDL_calloc(1, sizeof(MapStream));
+    if (!s) return false;
+
+    s->width = h.width;
+    s->height = h.height;
+    s->chunks_w = (h.width + CHUNK_MASK) >> MAP_STREAM_CHUNK_SHIFT;
+    s->chunks_h = (h.height + CHUNK_MASK) >> MAP_STREAM_CHUNK_SHIFT;
+    for (int l = 0; l < CHUNK_LAYERS; ++l) s->layer_offset[l] = h.layer_offset[l];
+
+    int table_size = 1;
+    while (table_size < max_chunks * 2) table_size <<= 1;
+
+    s->max_chunks = max_chunks;
+    s->table_mask = table_size - 1;
+    s->slots = (MapChunk*)SDL_calloc((size_t)max_chunks, sizeof(MapChunk));
+    s->table = (int*)SDL_malloc(sizeof(int) * (size_t)table_size);
+    s->queue = (int*)SDL_malloc(sizeof(int) * (size_t)max_chunks);
+    s->pool = (int*)SDL_malloc(sizeof(int) * CHUNK_LAYERS * CHUNK_TILES * (size_t)max_chunks);
+
+    s->io = SDL_IOFromFile(bin_path, "rb");
+    s->lock = SDL_CreateMutex();
+    s->wake = SDL_CreateCondition();
+    s->done = SDL_CreateCondition();
+
+    if (!s->slots || !s->table || !s->queue || !s->pool || !s->io || !s->lock || !s->wake || !s->done)
+    {
+        SDL_Log("MapStream_Open: setup failed for %s", bin_path);
+        MapStream_Close(s);
+        return false;
+    }
+
+    for (int i = 0; i < max_chunks; ++i)
+        s->slots[i].data = s->pool + (size_t)i * CHUNK_LAYERS * CHUNK_TILES;
+    table_rebuild(s);
+
+    s->thread = SDL_CreateThread(loader_main, "MapStream", s);
+    if (!s->thread)
+    {
+        SDL_Log("MapStream_Open: SDL_CreateThread failed: %s", SDL_GetError());
+        MapStream_Close(s);
+        return false;
+    }
+
+    LayeredMap_Shutdown(m);
+    m->width = h.width;
+    m->height = h.height;
+    m->tile_size = h.tile_size;
+    m->stream = s;
+
+    SDL_Log("Streaming map %s: %dx%d ts=%d, %d chunks of %dx%d resident max",
+            bin_path, h.width, h.height, h.tile_size, max_chunks, MAP_STREAM_CHUNK, MAP_STREAM_CHUNK);
+    return true;
+}
+
+void MapStream_Close(MapStream* s)
+{
+    if (!s) return;
+
+    if (s->thread)
+    {
+        SDL_LockMutex(s->lock);
+        s->quit = true;
+        SDL_BroadcastCondition(s->wake);
+        SDL_UnlockMutex(s->lock);
+        SDL_WaitThread(s->thread, NULL);
+    }
+
+    if (s->io) SDL_CloseIO(s->io);
+    if (s->done) SDL_DestroyCondition(s->done);
+    if (s->wake) SDL_DestroyCondition(s->wake);
+    if (s->lock) SDL_DestroyMutex(s->lock);
+
+    SDL_free(s->pool);
+    SDL_free(s->slots);
+    SDL_free(s->table);
+    SDL_free(s->queue);
+    SDL_free(s);
+}
+
+// ---------- Residency ----------
+
+// Pick a slot for a new chunk: a free one, else the least recently wanted
+// resident chunk that is not wanted this tick. Returns -1 if over budget.
+static int acquire_slot(MapStream* s, bool* evicted)
+{
+    int victim = -1;
+    for (int i = 0; i < s->max_chunks; ++i)
+    {
+        const MapChunk* c = &s->slots[i];
+        if (!c->in_use) { *evicted = false; return i; }
+        if (!c->resident || c->last_used == s->tick) continue;
+        if (victim < 0 || c->last_used < s->slots[victim].last_used) victim = i;
+    }
+
+    if (victim >= 0)
+    {
+        s->slots[victim].resident = false;
+        s->slots[victim].in_use = false;
+        s->evictions++;
+        *evicted = true;
+    }
+    return victim;
+}
+
+static void want_rect(MapStream* s, int cx0, int cy0, int cx1, int cy1)
+{
+    cx0 = SDL_max(cx0, 0);
+    cy0 = SDL_max(cy0, 0);
+    cx1 = SDL_min(cx1, s->chunks_w - 1);
+    cy1 = SDL_min(cy1, s->chunks_h - 1);
+
+    for (int cy = cy0; cy <= cy1; ++cy)
+    {
+        for (int cx = cx0; cx <= cx1; ++cx)
+        {
+            const int found = table_find(s, cx, cy);
+            if (found >= 0)
+            {
+                s->slots[found].last_used = s->tick;
+                continue;
+            }
+
+            bool evicted = false;
+            const int slot = acquire_slot(s, &evicted);
+            if (slot < 0) return; // budget exhausted by chunks wanted this tick
+
+            MapChunk* c = &s->slots[slot];
+            c->cx = cx;
+            c->cy = cy;
+            c->in_use = true;
+            c->last_used = s->tick;
+
+            // An evicted slot still sits in the table under its old key.
+            if (evicted) table_rebuild(s);
+            else table_insert(s, slot);
+
+            SDL_LockMutex(s->lock);
+            c->state = CHUNK_QUEUED;
+            s->queue[(s->q_head + s->q_count) % s->max_chunks] = slot;
+            s->q_count++;
+            SDL_SignalCondition(s->wake);
+            SDL_UnlockMutex(s->lock);
+        }
+    }
+}
+
+// Publish finished chunks; failed ones give their slot back (and leave the
+// table), so the next want_rect that covers them queues them again.
+static void publish_ready(MapStream* s)
+{
+    bool freed = false;
+    for (int i = 0; i < s->max_chunks; ++i)
+    {
+        MapChunk* c = &s->slots[i];
+        if (c->state == CHUNK_READY)
+        {
+            c->state = CHUNK_IDLE;
+            c->resident = true;
+        }
+        else if (c->state == CHUNK_FAILED)
+        {
+            c->state = CHUNK_IDLE;
+            c->in_use = false;
+            freed = true;
+        }
+    }
+    if (freed) table_rebuild(s);
+}
+
+void MapStream_Update(LayeredMap* m,
+                      float view_x, float view_y, float view_w, float view_h,
+                      float vel_x, float vel_y)
+{
+    if (!m || !m->stream || m->tile_size <= 0) return;
+    MapStream* s = m->stream;
+
+    s->tick++;
+
+    SDL_LockMutex(s->lock);
+    publish_ready(s);
+    SDL_UnlockMutex(s->lock);
+
+    const float chunk_px = (float)(m->tile_size * MAP_STREAM_CHUNK);
+    const int vx0 = (int)SDL_floorf(view_x / chunk_px);
+    const int vy0 = (int)SDL_floorf(view_y / chunk_px);
+    const int vx1 = (int)SDL_floorf((view_x + view_w) / chunk_px);
+    const int vy1 = (int)SDL_floorf((view_y + view_h) / chunk_px);
+
+    // Visible chunks first, then a one-chunk ring, then the look-ahead.
+    want_rect(s, vx0, vy0, vx1, vy1);
+    want_rect(s, vx0 - 1, vy0 - 1, vx1 + 1, vy1 + 1);
+
+    const float ax = view_x + vel_x * LOOKAHEAD_SEC;
+    const float ay = view_y + vel_y * LOOKAHEAD_SEC;
+    if (ax != view_x || ay != view_y)
+    {
+        want_rect(s,
+                  (int)SDL_floorf(ax / chunk_px), (int)SDL_floorf(ay / chunk_px),
+                  (int)SDL_floorf((ax + view_w) / chunk_px), (int)SDL_floorf((ay + view_h) / chunk_px));
+    }
+
+    if (!s->primed)
+    {
+        // First update: block until the visible chunks are in.
+        SDL_LockMutex(s->lock);
+        for (;;)
+        {
+            bool pending = false;
+            for (int i = 0; i < s->max_chunks; ++i)
+            {
+                const MapChunk* c = &s->slots[i];
+                if (c->state != CHUNK_QUEUED) continue;
+                if (c->cx >= vx0 && c->cx <= vx1 && c->cy >= vy0 && c->cy <= vy1) pending = true;
+            }
+            if (!pending) break;
+            SDL_WaitCondition(s->done, s->lock);
+        }
+        publish_ready(s);
+        SDL_UnlockMutex(s->lock);
+        s->primed = true;
+    }
+}
+
+// ---------- Reads ----------
+
+int MapStream_Tile(MapStream* s, int layer, int tx, int ty, int missing)
+{
+    const int cx = tx >> MAP_STREAM_CHUNK_SHIFT;
+    const int cy = ty >> MAP_STREAM_CHUNK_SHIFT;
+
+    const MapChunk* c = &s->slots[s->last_slot];
+    if (!c->resident || c->cx != cx || c->cy != cy)
+    {
+        const int slot = table_find(s, cx, cy);
+        if (slot < 0 || !s->slots[slot].resident)
+        {
+            s->misses++;
+            return missing;
+        }
+        s->last_slot = slot;
+        c = &s->slots[slot];
+    }
+
+    return c->data[layer * CHUNK_TILES + (ty & CHUNK_MASK) * MAP_STREAM_CHUNK + (tx & CHUNK_MASK)];
+}
+
+void MapStream_GetStats(const MapStream* s, MapStreamStats* out)
+{
+    if (!out) return;
+    memset(out, 0, sizeof(*out));
+    if (!s) return;
+
+    for (int i = 0; i < s->max_chunks; ++i)
+    {
+        if (s->slots[i].resident) out->resident++;
+        else if (s->slots[i].in_use) out->loading++;
+    }
+    out->budget = s->max_chunks;
+    SDL_LockMutex(s->lock);
+    out->loads = s->loads;
+    SDL_UnlockMutex(s->lock);
+    out->evictions = s->evictions;
+    out->misses = s->misses;
+}
@@ -0,0 +1,55 @@
+// src/world/map_stream.h
+#pragma once
+#include <stdbool.h>
+
+typedef struct LayeredMap LayeredMap;
+typedef struct MapStream MapStream;
+
+// Chunked world mode
+//
+// A streamed LayeredMap has no flat layer arrays. Tiles live in fixed-size
+// chunks read from a compiled map (.map3b) by a background thread; only a
+// bounded number of chunks is resident at any time, regardless of world size.
+// The LayeredMap accessors route through the stream, so collision and
+// rendering need no changes. Tiles in chunks that are not resident read as
+// empty and solid; a chunk that fails to read is never published and is
+// queued again by a later MapStream_Update.
+
+#define MAP_STREAM_CHUNK_SHIFT 5
+#define MAP_STREAM_CHUNK       (1 << MAP_STREAM_CHUNK_SHIFT)   // tiles per chunk side
+
+// LayeredMap_LoadFromFile streams compiled maps with at least this many tiles.
+#define MAP_STREAM_MIN_TILES   (2048 * 2048)
+
+// Default resident budget (chunks); 256 chunks of 32x32x4 ints = 4 MiB.
+#define MAP_STREAM_DEFAULT_CHUNKS 256
+
+// Open "bin_path" in streamed mode. max_chunks <= 0 uses the default budget.
+bool MapStream_Open(LayeredMap* m, const char* bin_path, int max_chunks);
+
+// Stop the loader thread and free all chunks (called by LayeredMap_Shutdown).
+void MapStream_Close(MapStream* s);
+
+// Main thread, once per update. The view rect and velocity are in world
+// pixels (velocity per second). Publishes finished chunks, queues loads for
+// the view plus a look-ahead along the velocity, and evicts the least
+// recently used chunks once over budget. The first call after opening loads
+// the visible chunks synchronously so the spawn area is never missing.
+void MapStream_Update(LayeredMap* m,
+                      float view_x, float view_y, float view_w, float view_h,
+                      float vel_x, float vel_y);
+
+// Tile read used by the LayeredMap accessors (coordinates already in range).
+int MapStream_Tile(MapStream* s, int layer, int tx, int ty, int missing);
+
+typedef struct MapStreamStats
+{
+    int resident;   // chunks currently readable
+    int loading;    // chunks queued or being read
+    int budget;     // max resident chunks
+    unsigned loads;
+    unsigned evictions;
+    unsigned misses; // reads that hit a non-resident chunk
+} MapStreamStats;
+
+void MapStream_GetStats(const MapStream* s, MapStreamStats* out);
@@ -0,0 +1,491 @@
+// src/world/map_text.c
+#include "map_text.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#define MAP_TEXT_BUF_SIZE (64 * 1024)
+#define MAP_TEXT_WORD_MAX 32
+
+// ---------- Buffered reader ----------
+
+typedef struct MapReader
+{
+    SDL_IOStream* io;
+    unsigned char* buf;
+    size_t pos;
+    size_t len;
+} MapReader;
+
+// Returns the next byte without consuming it, or -1 at end of stream.
+static inline int rd_peek(MapReader* r)
+{
+    if (r->pos < r->len) return r->buf[r->pos];
+
+    r->pos = 0;
+    r->len = SDL_ReadIO(r->io, r->buf, MAP_TEXT_BUF_SIZE);
+    return (r->len > 0) ? r->buf[0] : -1;
+}
+
+static inline bool is_sep(int c)
+{
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t' || c == ',' || c == '\v' || c == '\f';
+}
+
+static inline bool is_digit(int c)
+{
+    return c >= '0' && c <= '9';
+}
+
+static inline int hex_value(int c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+// ---------- Tokens ----------
+
+typedef enum MapTokKind
+{
+    TOK_END = 0,
+    TOK_INT,
+    TOK_WORD
+} MapTokKind;
+
+typedef struct MapTok
+{
+    MapTokKind kind;
+    int value;
+    char word[MAP_TEXT_WORD_MAX]; // upper-cased, truncated
+} MapTok;
+
+// Skip separators and comments, then scan exactly one token. Every byte is
+// looked at once; integers are accumulated while scanning. The cursor lives in
+// locals so the byte loads cannot alias it; it is written back on refill/exit.
+#define RD_PEEK() ((pos < len) ? (int)buf[pos] : (r->pos = pos, c = rd_peek(r), pos = r->pos, len = r->len, c))
+
+static void next_tok(MapReader* r, MapTok* t)
+{
+    const unsigned char* buf = r->buf;
+    size_t pos = r->pos;
+    size_t len = r->len;
+    int c = 0;
+
+    c = RD_PEEK();
+    for (;;)
+    {
+        while (c >= 0 && is_sep(c)) { pos++; c = RD_PEEK(); }
+        if (c != '#') break;
+        while (c >= 0 && c != '\n') { pos++; c = RD_PEEK(); }
+    }
+
+    if (c < 0)
+    {
+        r->pos = pos;
+        t->kind = TOK_END;
+        return;
+    }
+
+    bool neg = false;
+    if (c == '-')
+    {
+        neg = true;
+        pos++;
+        c = RD_PEEK();
+    }
+
+    if (is_digit(c))
+    {
+        int v = 0;
+        do
+        {
+            v = v * 10 + (c - '0');
+            pos++;
+            c = RD_PEEK();
+        } while (is_digit(c));
+
+        // Like atoi: trailing junk on a number token is ignored.
+        while (c >= 0 && !is_sep(c) && c != '#') { pos++; c = RD_PEEK(); }
+
+        r->pos = pos;
+        t->kind = TOK_INT;
+        t->value = neg ? -v : v;
+        return;
+    }
+
+    int n = 0;
+    if (neg) t->word[n++] = '-';
+    while (c >= 0 && !is_sep(c) && c != '#')
+    {
+        if (n < MAP_TEXT_WORD_MAX - 1)
+            t->word[n++] = (char)((c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c);
+        pos++;
+        c = RD_PEEK();
+    }
+    r->pos = pos;
+    t->word[n] = '\0';
+    t->kind = TOK_WORD;
+}
+
+#undef RD_PEEK
+
+// ---------- Loader ----------
+
+static int section_for(const char* word)
+{
+    if (strcmp(word, "GROUND") == 0) return MAP_LAYER_GROUND;
+    if (strcmp(word, "DECO") == 0) return MAP_LAYER_DECO;
+    if (strcmp(word, "COLLISION") == 0 || strcmp(word, "COLL") == 0) return MAP_LAYER_COLL;
+    if (strcmp(word, "INTERACT") == 0) return MAP_LAYER_INTERACT;
+    return -1;
+}
+
+// True if the token at the cursor is hex digits only, so a keyword such as
+// DECO (D, E, C are digits) is never taken for bits. Pulls the whole token
+// into the buffer first; one longer than the buffer is judged by its start.
+static bool hex_token_ahead(MapReader* r)
+{
+    size_t k = r->pos;
+    for (;;)
+    {
+        if (k == r->len)
+        {
+            if (r->pos == 0 && r->len == MAP_TEXT_BUF_SIZE) return true;
+
+            memmove(r->buf, r->buf + r->pos, r->len - r->pos);
+            k -= r->pos;
+            r->len -= r->pos;
+            r->pos = 0;
+
+            const size_t got = SDL_ReadIO(r->io, r->buf + r->len, MAP_TEXT_BUF_SIZE - r->len);
+            if (got == 0) return true;
+            r->len += got;
+        }
+
+        const int c = r->buf[k];
+        if (is_sep(c) || c == '#') return true;
+        if (hex_value(c) < 0) return false;
+        k++;
+    }
+}
+
+// BITS section body: hex digits, 4 tiles each (high bit first), straight
+// into the layer. Stops after n tiles or at the first token that is not all
+// hex digits; returns the tiles filled.
+static int read_bits(MapReader* r, int* dst, int n)
+{
+    int filled = 0;
+    while (filled < n)
+    {
+        int c = rd_peek(r);
+        if (c < 0) break;
+
+        if (is_sep(c))
+        {
+            r->pos++;
+            continue;
+        }
+        if (c == '#')
+        {
+            while (c >= 0 && c != '\n') { r->pos++; c = rd_peek(r); }
+            continue;
+        }
+
+        if (!hex_token_ahead(r)) break;
+
+        int v;
+        while (filled < n && (c = rd_peek(r)) >= 0 && (v = hex_value(c)) >= 0)
+        {
+            r->pos++;
+            for (int b = 3; b >= 0 && filled < n; --b)
+                dst[filled++] = (v >> b) & 1;
+        }
+    }
+    return filled;
+}
+
+static bool read_header(MapReader* r, MapTok* t, int dims[3])
+{
+    next_tok(r, t);
+    if (t->kind == TOK_WORD && strcmp(t->word, "MAP3") == 0)
+        next_tok(r, t);
+
+    // Header is three ints: width height tile_size
+    for (int i = 0; i < 3; ++i)
+    {
+        if (i > 0) next_tok(r, t);
+        if (t->kind != TOK_INT) return false;
+        dims[i] = t->value;
+    }
+    return true;
+}
+
+bool MapText_Load(LayeredMap* m, SDL_IOStream* io, const char* name)
+{
+    if (!m || !io) return false;
+    if (!name) name = "(stream)";
+
+    MapReader r = { io, NULL, 0, 0 };
+    r.buf = (unsigned char*)SDL_malloc(MAP_TEXT_BUF_SIZE);
+    if (!r.buf) return false;
+
+    MapTok t;
+    int dims[3] = { 0, 0, 0 };
+    if (!read_header(&r, &t, dims) || dims[0] <= 0 || dims[1] <= 0 || dims[2] <= 0)
+    {
+        SDL_Log("MapText_Load: bad dimensions in %s", name);
+        SDL_free(r.buf);
+        return false;
+    }
+
+    LayeredMap_Shutdown(m);
+    if (!LayeredMap_Init(m, dims[0], dims[1], dims[2]))
+    {
+        SDL_free(r.buf);
+        return false;
+    }
+
+    int* layers[MAP_LAYER_COUNT] = { m->ground, m->deco, m->coll, m->interact };
+    int  filled[MAP_LAYER_COUNT] = { 0, 0, 0, 0 };
+    const int n = m->width * m->height;
+
+    // Values outside a section (or past its end) are ignored.
+    int sec = -1;
+    bool rle = false;
+    int run = -1; // RLE: pending run length, -1 while expecting one
+
+    for (next_tok(&r, &t); t.kind != TOK_END; next_tok(&r, &t))
+    {
+        if (t.kind == TOK_INT)
+        {
+            if (sec < 0 || filled[sec] >= n) continue;
+
+            if (!rle)
+            {
+                layers[sec][filled[sec]++] = t.value;
+                continue;
+            }
+
+            if (run < 0)
+            {
+                run = t.value > 0 ? t.value : 0;
+                continue;
+            }
+
+            const int k = SDL_min(run, n - filled[sec]);
+            int* dst = layers[sec] + filled[sec];
+            for (int i = 0; i < k; ++i) dst[i] = t.value;
+            filled[sec] += k;
+            run = -1;
+            continue;
+        }
+
+        // Encoding tag directly after the section keyword
+        if (sec >= 0 && filled[sec] == 0 && !rle)
+        {
+            if (strcmp(t.word, "RLE") == 0)
+            {
+                rle = true;
+                continue;
+            }
+            if (strcmp(t.word, "BITS") == 0)
+            {
+                filled[sec] = read_bits(&r, layers[sec], n);
+                if (filled[sec] < n)
+                {
+                    SDL_Log("MapText_Load: BITS section in %s ends after %d of %d tiles", name, filled[sec], n);
+                    SDL_free(r.buf);
+                    LayeredMap_Shutdown(m);
+                    return false;
+                }
+                sec = -1;
+                continue;
+            }
+        }
+
+        const int s = section_for(t.word);
+        if (s < 0) continue; // unknown word; ignore
+
+        sec = s;
+        filled[sec] = 0;
+        rle = false;
+        run = -1;
+    }
+
+    SDL_free(r.buf);
+
+    // Missing sections are fine; they default to 0.
+    SDL_Log("Loaded map %s: %dx%d ts=%d sections: ground=%d deco=%d coll=%d interact=%d",
+            name, m->width, m->height, m->tile_size,
+            filled[MAP_LAYER_GROUND] == n, filled[MAP_LAYER_DECO] == n,
+            filled[MAP_LAYER_COLL] == n, filled[MAP_LAYER_INTERACT] == n);
+
+    return true;
+}
+
+// ---------- Writer ----------
+
+typedef struct MapWriter
+{
+    SDL_IOStream* io;
+    char* buf;
+    size_t len;
+    bool ok;
+} MapWriter;
+
+static void wr_flush(MapWriter* w)
+{
+    if (w->len > 0 && w->ok)
+        w->ok = SDL_WriteIO(w->io, w->buf, w->len) == w->len;
+    w->len = 0;
+}
+
+static void wr_char(MapWriter* w, char c)
+{
+    if (w->len == MAP_TEXT_BUF_SIZE) wr_flush(w);
+    w->buf[w->len++] = c;
+}
+
+static void wr_str(MapWriter* w, const char* s)
+{
+    while (*s) wr_char(w, *s++);
+}
+
+static void wr_int(MapWriter* w, int v)
+{
+    char tmp[12];
+    int n = 0;
+    unsigned u = (v < 0) ? 0u - (unsigned)v : (unsigned)v;
+    do { tmp[n++] = (char)('0' + u % 10u); u /= 10u; } while (u);
+    if (v < 0) wr_char(w, '-');
+    while (n) wr_char(w, tmp[--n]);
+}
+
+static int digits(int v)
+{
+    int d = (v < 0) ? 2 : 1;
+    unsigned u = (v < 0) ? 0u - (unsigned)v : (unsigned)v;
+    while (u >= 10u) { u /= 10u; d++; }
+    return d;
+}
+
+static int layer_value(const LayeredMap* m, int layer, int i)
+{
+    return LayeredMap_Tile(m, (LayeredMapLayer)layer, i % m->width, i / m->width);
+}
+
+typedef enum SectionEnc
+{
+    ENC_PLAIN = 0,
+    ENC_RLE,
+    ENC_BITS
+} SectionEnc;
+
+// Pick the encoding with the smallest output for one layer.
+static SectionEnc choose_encoding(const LayeredMap* m, int layer)
+{
+    const int n = m->width * m->height;
+    size_t plain = 0, rle = 0;
+    bool binary = true;
+
+    int prev = 0, run = 0;
+    for (int i = 0; i < n; ++i)
+    {
+        const int v = layer_value(m, layer, i);
+        plain += (size_t)digits(v) + 1;
+        if (v != 0 && v != 1) binary = false;
+
+        if (run > 0 && v == prev)
+        {
+            run++;
+            continue;
+        }
+        if (run > 0) rle += (size_t)digits(run) + (size_t)digits(prev) + 2;
+        prev = v;
+        run = 1;
+    }
+    rle += (size_t)digits(run) + (size_t)digits(prev) + 2;
+
+    const size_t bits = binary ? (size_t)(n + 3) / 4 + (size_t)(n + 255) / 256 : (size_t)-1;
+
+    if (bits <= rle && bits <= plain) return ENC_BITS;
+    return (rle < plain) ? ENC_RLE : ENC_PLAIN;
+}
+
+static void write_section(MapWriter* w, const LayeredMap* m, int layer, SectionEnc enc)
+{
+    static const char* names[MAP_LAYER_COUNT] = { "GROUND", "DECO", "COLL", "INTERACT" };
+    const int n = m->width * m->height;
+
+    wr_str(w, names[layer]);
+    wr_str(w, enc == ENC_RLE ? " RLE\n" : enc == ENC_BITS ? " BITS\n" : "\n");
+
+    if (enc == ENC_BITS)
+    {
+        static const char hex[] = "0123456789ABCDEF";
+        int col = 0;
+        for (int i = 0; i < n; i += 4)
+        {
+            int v = 0;
+            for (int b = 0; b < 4; ++b)
+                v = (v << 1) | ((i + b < n) ? layer_value(m, layer, i + b) : 0);
+            wr_char(w, hex[v]);
+            if (++col == 64) { wr_char(w, '\n'); col = 0; }
+        }
+        if (col) wr_char(w, '\n');
+    }
+    else if (enc == ENC_RLE)
+    {
+        int pairs = 0;
+        for (int i = 0; i < n;)
+        {
+            const int v = layer_value(m, layer, i);
+            int run = 1;
+            while (i + run < n && layer_value(m, layer, i + run) == v) run++;
+
+            if (pairs > 0) wr_char(w, (pairs % 16 == 0) ? '\n' : ' ');
+            wr_int(w, run);
+            wr_char(w, ' ');
+            wr_int(w, v);
+            pairs++;
+            i += run;
+        }
+        wr_char(w, '\n');
+    }
+    else
+    {
+        for (int i = 0; i < n; ++i)
+        {
+            wr_int(w, layer_value(m, layer, i));
+            wr_char(w, ((i + 1) % m->width == 0) ? '\n' : ' ');
+        }
+    }
+    wr_char(w, '\n');
+}
+
+bool MapText_Write(const LayeredMap* m, SDL_IOStream* io, bool encode)
+{
+    if (!m || !io || m->width <= 0 || m->height <= 0 || m->stream) return false;
+
+    MapWriter w = { io, NULL, 0, true };
+    w.buf = (char*)SDL_malloc(MAP_TEXT_BUF_SIZE);
+    if (!w.buf) return false;
+
+    wr_str(&w, "MAP3 ");
+    wr_int(&w, m->width);
+    wr_char(&w, ' ');
+    wr_int(&w, m->height);
+    wr_char(&w, ' ');
+    wr_int(&w, m->tile_size);
+    wr_str(&w, "\n\n");
+
+    for (int layer = 0; layer < MAP_LAYER_COUNT; ++layer)
+        write_section(&w, m, layer, encode ? choose_encoding(m, layer) : ENC_PLAIN);
+
+    wr_flush(&w);
+    SDL_free(w.buf);
+    return w.ok;
+}
@@ -0,0 +1,34 @@
+// src/world/map_text.h
+#pragma once
+#include <stdbool.h>
+
+typedef struct LayeredMap LayeredMap;
+typedef struct SDL_IOStream SDL_IOStream;
+
+// Text map format (.map3)
+//
+//   MAP3 <width> <height> <tile_size>     (the MAP3 keyword is optional)
+//   GROUND    <width*height ints>
+//   DECO      <width*height ints>
+//   COLL      <width*height ints>          (COLLISION also accepted)
+//   INTERACT  <width*height ints>
+//
+// Keywords are case-insensitive, values are separated by whitespace or
+// commas, and '#' starts a comment that runs to the end of the line.
+// Missing sections default to 0.
+//
+// A section keyword may be followed by an encoding tag:
+//   GROUND RLE   <count value> pairs, e.g. "640 1" for 640 tiles of id 1
+//   COLL BITS    0/1 tiles as hex digits, 4 tiles per digit, high bit
+//                first; exactly ceil(width*height/4) digits (fewer fails
+//                the load)
+// Encoded sections are decoded straight into the layer while reading.
+
+// Parse a text map from a stream in a single pass over a small buffer; the
+// file never has to be resident. "name" is only used for log messages.
+// Does not close the stream.
+bool MapText_Load(LayeredMap* m, SDL_IOStream* io, const char* name);
+
+// Write a loaded map (any storage but streamed) as text. With "encode" each
+// section uses whichever of plain, RLE or BITS is smallest.
+bool MapText_Write(const LayeredMap* m, SDL_IOStream* io, bool encode);
@@ -0,0 +1,302 @@
+// src/world/map_watch.c
+#if defined(__linux__)
+#define _DEFAULT_SOURCE
+#endif
+
+#include "map_watch.h"
+#include "layered_map.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#define WATCH_PATH_MAX    256
+#define WATCH_CHANGED_MAX 8
+#define WATCH_DEBOUNCE_NS (50 * 1000000ull)   // editors write in bursts
+#define WATCH_TICK_MS     100
+
+struct MapWatch
+{
+    SDL_Thread* thread;
+    SDL_Mutex* lock;
+    SDL_AtomicInt quit;
+
+    // All below guarded by lock
+    char file[WATCH_PATH_MAX];   // live map ("" = none)
+    char dir[WATCH_PATH_MAX];    // "" = current directory
+    const char* base;            // points into file
+    unsigned generation;         // bumped by MapWatch_SetFile
+
+    bool ready;
+    LayeredMap result;
+
+    char changed[WATCH_CHANGED_MAX][WATCH_PATH_MAX];
+    int changed_head;
+    int changed_count;
+};
+
+static bool has_suffix(const char* s, const char* suffix)
+{
+    const size_t n = SDL_strlen(s), k = SDL_strlen(suffix);
+    return n >= k && SDL_strcmp(s + n - k, suffix) == 0;
+}
+
+// Parse the live map on the watcher thread and publish it.
+static void reparse(MapWatch* w)
+{
+    char path[WATCH_PATH_MAX];
+
+    SDL_LockMutex(w->lock);
+    SDL_strlcpy(path, w->file, sizeof(path));
+    const unsigned gen = w->generation;
+    SDL_UnlockMutex(w->lock);
+
+    if (!path[0]) return;
+
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!LayeredMap_LoadTextFile(&m, path)) return; // mid-save or broken; wait for the next write
+
+    SDL_LockMutex(w->lock);
+    if (gen == w->generation)
+    {
+        if (w->ready) LayeredMap_Shutdown(&w->result);
+        w->result = m;
+        w->ready = true;
+        memset(&m, 0, sizeof(m));
+    }
+    SDL_UnlockMutex(w->lock);
+
+    LayeredMap_Shutdown(&m);
+}
+
+// A .map3 named "name" in the watched directory was written.
+static bool note_write(MapWatch* w, const char* name)
+{
+    if (!has_suffix(name, ".map3")) return false;
+
+    bool live = false;
+    SDL_LockMutex(w->lock);
+    if (w->base && SDL_strcmp(w->base, name) == 0)
+    {
+        live = true;
+    }
+    else if (w->changed_count < WATCH_CHANGED_MAX)
+    {
+        const int slot = (w->changed_head + w->changed_count) % WATCH_CHANGED_MAX;
+        if (w->dir[0]) SDL_snprintf(w->changed[slot], WATCH_PATH_MAX, "%s/%s", w->dir, name);
+        else SDL_strlcpy(w->changed[slot], name, WATCH_PATH_MAX);
+        w->changed_count++;
+    }
+    SDL_UnlockMutex(w->lock);
+    return live;
+}
+
+#if defined(__linux__)
+
+static int watch_main(void* user)
+{
+    MapWatch* w = (MapWatch*)user;
+
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+    {
+        SDL_Log("MapWatch: inotify unavailable, hot reload disabled");
+        return 0;
+    }
+
+    int wd = -1;
+    char watched_dir[WATCH_PATH_MAX] = "";
+    bool watching = false;
+    Uint64 due = 0;
+
+    // Aligned for struct inotify_event
+    union { struct inotify_event ev; char bytes[4096]; } buf;
+
+    while (!SDL_GetAtomicInt(&w->quit))
+    {
+        char dir[WATCH_PATH_MAX];
+        SDL_LockMutex(w->lock);
+        SDL_strlcpy(dir, w->dir, sizeof(dir));
+        const bool have_file = w->file[0] != '\0';
+        SDL_UnlockMutex(w->lock);
+
+        if (have_file && (!watching || SDL_strcmp(dir, watched_dir) != 0))
+        {
+            if (wd >= 0) inotify_rm_watch(fd, wd);
+            wd = inotify_add_watch(fd, dir[0] ? dir : ".", IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (wd < 0) SDL_Log("MapWatch: cannot watch %s", dir[0] ? dir : ".");
+            SDL_strlcpy(watched_dir, dir, sizeof(watched_dir));
+            watching = true;
+            due = 0;
+        }
+
+        struct pollfd p = { fd, POLLIN, 0 };
+        if (poll(&p, 1, WATCH_TICK_MS) > 0)
+        {
+            ssize_t len;
+            while ((len = read(fd, buf.bytes, sizeof(buf.bytes))) > 0)
+            {
+                for (char* at = buf.bytes; at < buf.bytes + len;)
+                {
+                    const struct inotify_event* ev = (const struct inotify_event*)(void*)at;
+                    if (ev->len > 0 && note_write(w, ev->name))
+                        due = SDL_GetTicksNS() + WATCH_DEBOUNCE_NS;
+                    at += sizeof(struct inotify_event) + ev->len;
+                }
+            }
+        }
+
+        if (due && SDL_GetTicksNS() >= due)
+        {
+            due = 0;
+            reparse(w);
+        }
+    }
+
+    close(fd);
+    return 0;
+}
+
+#else
+
+// Portable fallback: poll the live map's modification time.
+static int watch_main(void* user)
+{
+    MapWatch* w = (MapWatch*)user;
+
+    char last_file[WATCH_PATH_MAX] = "";
+    SDL_Time last_mtime = 0;
+    Uint64 due = 0;
+
+    while (!SDL_GetAtomicInt(&w->quit))
+    {
+        char file[WATCH_PATH_MAX];
+        SDL_LockMutex(w->lock);
+        SDL_strlcpy(file, w->file, sizeof(file));
+        SDL_UnlockMutex(w->lock);
+
+        SDL_PathInfo info;
+        if (file[0] && SDL_GetPathInfo(file, &info))
+        {
+            if (SDL_strcmp(file, last_file) != 0)
+            {
+                SDL_strlcpy(last_file, file, sizeof(last_file));
+                last_mtime = info.modify_time;
+                due = 0;
+            }
+            else if (info.modify_time != last_mtime)
+            {
+                last_mtime = info.modify_time;
+                due = SDL_GetTicksNS() + WATCH_DEBOUNCE_NS;
+            }
+        }
+
+        if (due && SDL_GetTicksNS() >= due)
+        {
+            due = 0;
+            reparse(w);
+        }
+
+        SDL_Delay(WATCH_TICK_MS);
+    }
+    return 0;
+}
+
+#endif
+
+MapWatch* MapWatch_Create(void)
+{
+    MapWatch* w = (MapWatch*)SDL_calloc(1, sizeof(MapWatch));
+    if (!w) return NULL;
+
+    w->lock = SDL_CreateMutex();
+    if (w->lock)
+        w->thread = SDL_CreateThread(watch_main, "MapWatch", w);
+
+    if (!w->thread)
+    {
+        SDL_Log("MapWatch_Create: setup failed: %s", SDL_GetError());
+        MapWatch_Destroy(w);
+        return NULL;
+    }
+    return w;
+}
+
+void MapWatch_Destroy(MapWatch* w)
+{
+    if (!w) return;
+
+    if (w->thread)
+    {
+        SDL_SetAtomicInt(&w->quit, 1);
+        SDL_WaitThread(w->thread, NULL);
+    }
+
+    if (w->ready) LayeredMap_Shutdown(&w->result);
+    if (w->lock) SDL_DestroyMutex(w->lock);
+    SDL_free(w);
+}
+
+void MapWatch_SetFile(MapWatch* w, const char* path)
+{
+    if (!w || !path) return;
+
+    SDL_LockMutex(w->lock);
+    if (SDL_strcmp(w->file, path) != 0)
+    {
+        SDL_strlcpy(w->file, path, sizeof(w->file));
+
+        const char* slash = SDL_strrchr(w->file, '/');
+        w->base = slash ? slash + 1 : w->file;
+        const size_t dir_len = slash ? (size_t)(slash - w->file) : 0;
+        SDL_strlcpy(w->dir, w->file, SDL_min(dir_len + 1, sizeof(w->dir)));
+
+        w->generation++;
+        if (w->ready)
+        {
+            LayeredMap_Shutdown(&w->result);
+            w->ready = false;
+        }
+    }
+    SDL_UnlockMutex(w->lock);
+}
+
+bool MapWatch_TakeReload(MapWatch* w, LayeredMap* out)
+{
+    if (!w || !out) return false;
+
+    bool ok = false;
+    SDL_LockMutex(w->lock);
+    if (w->ready)
+    {
+        *out = w->result;
+        memset(&w->result, 0, sizeof(w->result));
+        w->ready = false;
+        ok = true;
+    }
+    SDL_UnlockMutex(w->lock);
+    return ok;
+}
+
+bool MapWatch_NextChanged(MapWatch* w, char* out, size_t cap)
+{
+    if (!w || !out || cap == 0) return false;
+
+    bool ok = false;
+    SDL_LockMutex(w->lock);
+    if (w->changed_count > 0)
+    {
+        SDL_strlcpy(out, w->changed[w->changed_head], cap);
+        w->changed_head = (w->changed_head + 1) % WATCH_CHANGED_MAX;
+        w->changed_count--;
+        ok = true;
+    }
+    SDL_UnlockMutex(w->lock);
+    return ok;
+}
@@ -0,0 +1,28 @@
+// src/world/map_watch.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct LayeredMap LayeredMap;
+typedef struct MapWatch MapWatch;
+
+// Map hot reload
+//
+// A background thread watches the directory of the live map (inotify on
+// Linux, modification-time polling of the live map elsewhere). When the live
+// map's text file is saved it is reparsed on that thread; the main thread
+// takes the parsed copy and applies it with LayeredMap_ApplyDiff. Saves to
+// other .map3 files in the same directory are reported so cached copies can
+// be dropped.
+
+MapWatch* MapWatch_Create(void);
+void MapWatch_Destroy(MapWatch* w);
+
+// Watch "path" as the live map. Drops a reload pending for the previous one.
+void MapWatch_SetFile(MapWatch* w, const char* path);
+
+// Move a freshly parsed copy of the live map into *out (must be empty).
+bool MapWatch_TakeReload(MapWatch* w, LayeredMap* out);
+
+// Pop the path of another map saved since the last call.
+bool MapWatch_NextChanged(MapWatch* w, char* out, size_t cap);
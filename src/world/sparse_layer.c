@@ -0,0 +1,235 @@
+// src/world/sparse_layer.c
+#include "sparse_layer.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+static uint32_t hash_index(uint32_t key, int bits)
+{
+    return (key * 0x9E3779B1u) >> (32 - bits);
+}
+
+static void table_insert(SparseLayer* s, uint32_t key, int value)
+{
+    const uint32_t mask = (1u << s->table_bits) - 1u;
+
+    uint32_t i = hash_index(key, s->table_bits);
+    while (s->table[i].key != 0) i = (i + 1) & mask;
+    s->table[i].key = key;
+    s->table[i].value = value;
+}
+
+SparseLayer* SparseLayer_FromDense(const int* dense, int width, int height)
+{
+    if (!dense || width <= 0 || height <= 0) return NULL;
+
+    const size_t n = (size_t)width * (size_t)height;
+    int count = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (dense[i] != 0) count++;
+
+    SparseLayer* s = (SparseLayer*)SDL_calloc(1, sizeof(SparseLayer));
+    if (!s) return NULL;
+
+    s->width = width;
+    s->height = height;
+    s->count = count;
+
+    // At most half full keeps probe chains short.
+    s->table_bits = 4;
+    while ((1 << s->table_bits) < count * 2) s->table_bits++;
+
+    s->capacity = SDL_max(count, 1);
+    s->cells = (SparseCell*)SDL_malloc(sizeof(SparseCell) * (size_t)s->capacity);
+    s->table = (SparseSlot*)SDL_calloc((size_t)1 << s->table_bits, sizeof(SparseSlot));
+    if (!s->cells || !s->table)
+    {
+        SparseLayer_Destroy(s);
+        return NULL;
+    }
+
+    // Row-major scan yields cells already sorted by (ty, tx).
+    int c = 0;
+    for (int ty = 0; ty < height; ++ty)
+    {
+        const int* row = dense + (size_t)ty * (size_t)width;
+        for (int tx = 0; tx < width; ++tx)
+        {
+            if (row[tx] == 0) continue;
+            s->cells[c].tx = tx;
+            s->cells[c].ty = ty;
+            s->cells[c].value = row[tx];
+            table_insert(s, (uint32_t)(ty * width + tx) + 1u, row[tx]);
+            c++;
+        }
+    }
+
+    return s;
+}
+
+void SparseLayer_Destroy(SparseLayer* s)
+{
+    if (!s) return;
+    SDL_free(s->cells);
+    SDL_free(s->table);
+    SDL_free(s);
+}
+
+int SparseLayer_Get(const SparseLayer* s, int tx, int ty)
+{
+    if (s->count == 0) return 0;
+
+    const uint32_t mask = (1u << s->table_bits) - 1u;
+    const uint32_t key = (uint32_t)(ty * s->width + tx) + 1u;
+
+    for (uint32_t i = hash_index(key, s->table_bits);; i = (i + 1) & mask)
+    {
+        if (s->table[i].key == key) return s->table[i].value;
+        if (s->table[i].key == 0) return 0;
+    }
+}
+
+// ---------- Editing ----------
+
+static int table_find(const SparseLayer* s, uint32_t key)
+{
+    const uint32_t mask = (1u << s->table_bits) - 1u;
+    for (uint32_t i = hash_index(key, s->table_bits);; i = (i + 1) & mask)
+    {
+        if (s->table[i].key == key) return (int)i;
+        if (s->table[i].key == 0) return -1;
+    }
+}
+
+// Backward-shift deletion keeps probe chains intact without tombstones.
+static void table_remove(SparseLayer* s, uint32_t i)
+{
+    const uint32_t mask = (1u << s->table_bits) - 1u;
+    for (;;)
+    {
+        s->table[i].key = 0;
+        uint32_t j = i;
+        for (;;)
+        {
+            j = (j + 1) & mask;
+            if (s->table[j].key == 0) return;
+
+            // Move the entry back unless its home lies cyclically in (i, j].
+            const uint32_t home = hash_index(s->table[j].key, s->table_bits);
+            const bool stays = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+            if (!stays)
+            {
+                s->table[i] = s->table[j];
+                i = j;
+                break;
+            }
+        }
+    }
+}
+
+static bool table_rebuild(SparseLayer* s, int bits)
+{
+    SparseSlot* t = (SparseSlot*)SDL_calloc((size_t)1 << bits, sizeof(SparseSlot));
+    if (!t) return false;
+
+    SDL_free(s->table);
+    s->table = t;
+    s->table_bits = bits;
+    for (int c = 0; c < s->count; ++c)
+        table_insert(s, (uint32_t)(s->cells[c].ty * s->width + s->cells[c].tx) + 1u, s->cells[c].value);
+    return true;
+}
+
+// First cell at or after (ty, tx) in row order.
+static int lower_bound_cell(const SparseLayer* s, int tx, int ty)
+{
+    int lo = 0, hi = s->count;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        const SparseCell* c = &s->cells[mid];
+        if (c->ty < ty || (c->ty == ty && c->tx < tx)) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+bool SparseLayer_Set(SparseLayer* s, int tx, int ty, int value)
+{
+    const uint32_t key = (uint32_t)(ty * s->width + tx) + 1u;
+    const int slot = table_find(s, key);
+
+    if (slot >= 0)
+    {
+        const int c = lower_bound_cell(s, tx, ty);
+        if (value != 0)
+        {
+            s->table[slot].value = value;
+            s->cells[c].value = value;
+            return true;
+        }
+
+        table_remove(s, (uint32_t)slot);
+        memmove(&s->cells[c], &s->cells[c + 1], sizeof(SparseCell) * (size_t)(s->count - c - 1));
+        s->count--;
+        return true;
+    }
+
+    if (value == 0) return true;
+
+    if (s->count == s->capacity)
+    {
+        const int cap = s->capacity * 2;
+        SparseCell* cells = (SparseCell*)SDL_realloc(s->cells, sizeof(SparseCell) * (size_t)cap);
+        if (!cells) return false;
+        s->cells = cells;
+        s->capacity = cap;
+    }
+    if ((s->count + 1) * 2 > (1 << s->table_bits) && !table_rebuild(s, s->table_bits + 1))
+        return false;
+
+    const int c = lower_bound_cell(s, tx, ty);
+    memmove(&s->cells[c + 1], &s->cells[c], sizeof(SparseCell) * (size_t)(s->count - c));
+    s->cells[c].tx = tx;
+    s->cells[c].ty = ty;
+    s->cells[c].value = value;
+    s->count++;
+
+    table_insert(s, key, value);
+    return true;
+}
+
+// ---------- Queries ----------
+
+// First cell with row >= ty.
+static int lower_bound_row(const SparseLayer* s, int ty)
+{
+    int lo = 0, hi = s->count;
+    while (lo < hi)
+    {
+        const int mid = (lo + hi) / 2;
+        if (s->cells[mid].ty < ty) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+int SparseLayer_RowRange(const SparseLayer* s, int ty0, int ty1, int* out_first)
+{
+    if (!s || ty1 <= ty0)
+    {
+        if (out_first) *out_first = 0;
+        return 0;
+    }
+
+    const int first = lower_bound_row(s, ty0);
+    const int end = lower_bound_row(s, ty1);
+    if (out_first) *out_first = first;
+    return end - first;
+}
+
+size_t SparseLayer_MemoryBytes(const SparseLayer* s)
+{
+    if (!s) return 0;
+    return sizeof(*s) + sizeof(SparseCell) * (size_t)s->capacity + sizeof(SparseSlot) * ((size_t)1 << s->table_bits);
+}
@@ -0,0 +1,52 @@
+// src/world/sparse_layer.h
+#pragma once
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Sparse tile layer for mostly-empty layers (interact, most deco).
+//
+// Non-zero cells are kept in one array sorted by (ty, tx) so callers can
+// iterate only those, plus an open-addressing hash of (tile index, value) for
+// O(1) point lookups. Everything not listed reads as 0.
+
+typedef struct SparseCell
+{
+    int tx;
+    int ty;
+    int value;
+} SparseCell;
+
+typedef struct SparseSlot
+{
+    uint32_t key;        // tile index + 1, 0 = empty
+    int      value;
+} SparseSlot;
+
+typedef struct SparseLayer
+{
+    int width;
+    int height;
+
+    SparseCell* cells;   // count entries, sorted by (ty, tx)
+    int count;
+    int capacity;
+
+    SparseSlot* table;   // 1 << table_bits entries
+    int table_bits;
+} SparseLayer;
+
+// Build from a dense row-major layer. Returns NULL on allocation failure.
+SparseLayer* SparseLayer_FromDense(const int* dense, int width, int height);
+void SparseLayer_Destroy(SparseLayer* s);
+
+// Coordinates must be in range (the LayeredMap accessors check bounds).
+int SparseLayer_Get(const SparseLayer* s, int tx, int ty);
+
+// Insert, update or (value 0) remove one cell. False only if out of memory.
+bool SparseLayer_Set(SparseLayer* s, int tx, int ty, int value);
+
+// Cells with ty0 <= ty < ty1, as a [first, first+count) slice of s->cells.
+int SparseLayer_RowRange(const SparseLayer* s, int ty0, int ty1, int* out_first);
+
+size_t SparseLayer_MemoryBytes(const SparseLayer* s);
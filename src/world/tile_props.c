@@ -0,0 +1,158 @@
+// src/world/tile_props.c
+#include "tile_props.h"
+
+#include <SDL3/SDL.h>
+#include <string.h>
+
+static const TileProps* g_active = NULL;
+
+static const char* const k_flag_names[] = { "solid", "opaque", "animated", "blocks_light" };
+static const char* const k_footstep_names[TILE_FOOTSTEP_COUNT] = {
+    "none", "stone", "grass", "wood", "water", "sand"
+};
+
+void TileProps_SetDefaults(TileProps* p)
+{
+    if (!p) return;
+    memset(p, 0, sizeof(*p));
+    memset(p->flags, TILE_OPAQUE, sizeof(p->flags));
+    p->flags[0] = 0;
+}
+
+static bool is_space(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+// Next whitespace-separated token of *s (NUL-terminated in place), or NULL.
+static char* next_token(char** s)
+{
+    char* t = *s;
+    while (is_space(*t)) ++t;
+    if (!*t) return NULL;
+
+    char* end = t;
+    while (*end && !is_space(*end)) ++end;
+    if (*end) *end++ = '\0';
+    *s = end;
+    return t;
+}
+
+static bool parse_ids(const char* t, int* first, int* last)
+{
+    char* end = NULL;
+    const long a = SDL_strtol(t, &end, 10);
+    long b = a;
+    if (end == t) return false;
+    if (*end == '-')
+    {
+        const char* s = end + 1;
+        b = SDL_strtol(s, &end, 10);
+        if (end == s) return false;
+    }
+    if (*end || a < 0 || b < a || b >= TILE_PROPS_MAX_IDS) return false;
+    *first = (int)a;
+    *last = (int)b;
+    return true;
+}
+
+static bool parse_property(const char* t, uint8_t* flags, int* autotile)
+{
+    if (SDL_strncasecmp(t, "autotile=", 9) == 0)
+    {
+        char* end = NULL;
+        const long first = SDL_strtol(t + 9, &end, 10);
+        if (end == t + 9 || *end || first <= 0 || first > TILE_PROPS_MAX_IDS - TILE_AUTOTILE_VARIANTS) return false;
+        *autotile = (int)first;
+        return true;
+    }
+
+    for (int i = 0; i < (int)SDL_arraysize(k_flag_names); ++i)
+    {
+        if (SDL_strcasecmp(t, k_flag_names[i]) == 0)
+        {
+            *flags |= (uint8_t)(1u << i);
+            return true;
+        }
+    }
+    for (int i = 0; i < TILE_FOOTSTEP_COUNT; ++i)
+    {
+        if (SDL_strcasecmp(t, k_footstep_names[i]) == 0)
+        {
+            *flags = (uint8_t)((*flags & 0x0Fu) | ((unsigned)i << TILE_FOOTSTEP_SHIFT));
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TileProps_LoadFile(TileProps* p, const char* path)
+{
+    if (!p || !path) return false;
+
+    size_t size = 0;
+    char* text = (char*)SDL_LoadFile(path, &size);
+    if (!text)
+    {
+        SDL_Log("TileProps_LoadFile: cannot read %s", path);
+        return false;
+    }
+
+    TileProps* next = (TileProps*)SDL_malloc(sizeof(TileProps));
+    if (!next)
+    {
+        SDL_free(text);
+        return false;
+    }
+    *next = *p;
+
+    bool ok = true;
+    int line_no = 0;
+    for (char* line = text; ok && line;)
+    {
+        char* eol = SDL_strchr(line, '\n');
+        if (eol) *eol = '\0';
+        char* comment = SDL_strchr(line, '#');
+        if (comment) *comment = '\0';
+        line_no++;
+
+        char* s = line;
+        const char* t = next_token(&s);
+        if (t)
+        {
+            int first = 0, last = 0, autotile = 0;
+            uint8_t flags = 0;
+            ok = parse_ids(t, &first, &last);
+            while (ok && (t = next_token(&s)) != NULL) ok = parse_property(t, &flags, &autotile);
+
+            if (ok)
+            {
+                memset(next->flags + first, flags, (size_t)(last - first + 1));
+                for (int id = first; id <= last; ++id) next->autotile[id] = (uint16_t)autotile;
+            }
+            else SDL_Log("TileProps_LoadFile: %s:%d: bad entry near '%s'", path, line_no, t ? t : "");
+        }
+        line = eol ? eol + 1 : NULL;
+    }
+
+    if (ok)
+    {
+        next->any_autotile = false;
+        for (int id = 0; id < TILE_PROPS_MAX_IDS; ++id)
+            if (next->autotile[id]) next->any_autotile = true;
+        *p = *next;
+    }
+    SDL_free(next);
+    SDL_free(text);
+    return ok;
+}
+
+void TileProps_SetActive(const TileProps* p)
+{
+    g_active = p;
+}
+
+const TileProps* TileProps_Active(void)
+{
+    return g_active;
+}
@@ -0,0 +1,87 @@
+// src/world/tile_props.h
+#pragma once
+#include <stdbool.h>
+#include <stdint.h>
+
+// Per-tileset tile properties
+//
+// One flag byte per tile id, so per-tile decisions are a table load instead
+// of comparisons against hard-coded ids; new tile types only need a line in
+// the tileset's property file:
+//
+//   # id[-last]  properties...
+//   1            opaque stone
+//   3            solid opaque blocks_light stone
+//   10-13        animated water
+//   5            solid opaque autotile=32
+//
+// Properties are solid, opaque, animated, blocks_light and one footstep
+// class (stone, grass, wood, water, sand). A listed id gets exactly the
+// properties on its line; ids not listed keep the defaults (non-zero ids
+// opaque, nothing else). Ids outside the table read as id 0.
+//
+// "autotile=N" makes a deco id draw as one of 16 variants, N + mask, where
+// mask has bit 0/1/2/3 set when the tile north/east/south/west holds the
+// same id (or lies off the map). See autotile.h.
+
+#define TILE_PROPS_MAX_IDS      4096
+#define TILE_PROPS_DEFAULT_PATH "assets/tiles/tileset.props"
+
+#define TILE_SOLID         0x01u   // folded into collision when a map is parsed or a tile set
+#define TILE_OPAQUE        0x02u   // art covers the whole cell
+#define TILE_ANIMATED      0x04u
+#define TILE_BLOCKS_LIGHT  0x08u
+#define TILE_FOOTSTEP_SHIFT 4      // footstep class in the high nibble
+
+#define TILE_AUTOTILE_N    0x01u
+#define TILE_AUTOTILE_E    0x02u
+#define TILE_AUTOTILE_S    0x04u
+#define TILE_AUTOTILE_W    0x08u
+#define TILE_AUTOTILE_VARIANTS 16
+
+typedef enum TileFootstep
+{
+    TILE_FOOTSTEP_NONE = 0,
+    TILE_FOOTSTEP_STONE,
+    TILE_FOOTSTEP_GRASS,
+    TILE_FOOTSTEP_WOOD,
+    TILE_FOOTSTEP_WATER,
+    TILE_FOOTSTEP_SAND,
+    TILE_FOOTSTEP_COUNT
+} TileFootstep;
+
+typedef struct TileProps
+{
+    uint8_t flags[TILE_PROPS_MAX_IDS];
+    uint16_t autotile[TILE_PROPS_MAX_IDS];   // first variant id, 0 = not autotiled
+    bool any_autotile;
+} TileProps;
+
+void TileProps_SetDefaults(TileProps* p);
+
+// Parse a property file over the current table. On failure the table is
+// left unchanged.
+bool TileProps_LoadFile(TileProps* p, const char* path);
+
+static inline unsigned TileProps_Flags(const TileProps* p, int id)
+{
+    return p->flags[(unsigned)id < TILE_PROPS_MAX_IDS ? (unsigned)id : 0u];
+}
+
+static inline TileFootstep TileProps_Footstep(const TileProps* p, int id)
+{
+    return (TileFootstep)(TileProps_Flags(p, id) >> TILE_FOOTSTEP_SHIFT);
+}
+
+// Id to draw for deco "id" given its autotile neighbor mask.
+static inline int TileProps_AutotileId(const TileProps* p, int id, unsigned mask)
+{
+    const int first = p->autotile[(unsigned)id < TILE_PROPS_MAX_IDS ? (unsigned)id : 0u];
+    return first ? first + (int)mask : id;
+}
+
+// Table used when maps are parsed (LayeredMap_LoadTextFile folds TILE_SOLID
+// ground/deco ids into the collision layer). Set it once at startup, before
+// any map loads; map loading may run on worker threads. NULL = none.
+void TileProps_SetActive(const TileProps* p);
+const TileProps* TileProps_Active(void);
@@ -1,5 +1,6 @@
 // src/world/tilemap.c
 #include "tilemap.h"
+#include "tile_props.h"
 
 #include <SDL3/SDL.h>
 #include <stdio.h>
@@ -47,11 +48,15 @@ void Tilemap_Set(Tilemap* m, int tx, int ty, int id)
 
 bool Tilemap_IsSolidId(int id)
 {
-    return (id == 1) || (id == 3);
+    const TileProps* p = TileProps_Active();
+    if (p) return (TileProps_Flags(p, id) & TILE_SOLID) != 0;
+    return (id == 1) || (id == 3); // legacy ids, no property table loaded
 }
 
 bool Tilemap_IsSolidTile(const Tilemap* m, int tx, int ty)
 {
+    // Not via the id: Tilemap_Get's wall id 1 is floor in the property table
+    if (!m || !m->tiles || tx < 0 || ty < 0 || tx >= m->width || ty >= m->height) return true;
     return Tilemap_IsSolidId(Tilemap_Get(m, tx, ty));
 }
 
@@ -15,6 +15,11 @@ void Tilemap_Shutdown(Tilemap* m);
 int  Tilemap_Get(const Tilemap* m, int tx, int ty);   // out of bounds => solid wall (1)
 void Tilemap_Set(Tilemap* m, int tx, int ty, int id);
 
+// Solidity comes from the active tile properties (TILE_SOLID, tile_props.h)
+// when a table is set, which changes the legacy meaning: with the shipped
+// tileset.props ids 2 and 3 are solid and id 1 is floor, where the rule
+// without a table is still ids 1 and 3. Out-of-bounds tiles are solid
+// either way.
 bool Tilemap_IsSolidId(int id);
 bool Tilemap_IsSolidTile(const Tilemap* m, int tx, int ty);
 bool Tilemap_IsSolidAtWorld(const Tilemap* m, float wx, float wy);
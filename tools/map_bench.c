@@ -0,0 +1,1384 @@
+// tools/map_bench.c
+// Map loading / access benchmarks.
+//
+//   map_bench parse [max_size]     synthetic MAP3 text, 256x256 .. max_size (default 4096)
+//   map_bench file a.map3 [...]    time LayeredMap_LoadFromFile on real maps
+//   map_bench packed [size]        dense vs packed storage: footprint, render/collision scans
+//   map_bench span [size]          per-tile accessors vs row spans for the render/collision scans
+//   map_bench edit [size]          mass edits: edit cost, then dirty-chunk vs full rebuild of
+//                                  derived per-chunk data
+//   map_bench rect [size]          "any solid in rect?" / solid count: row loop vs summed-area table
+//   map_bench rects [size] [a.map3 ...]  merged collision rects: bake, overlay draws, box queries
+//   map_bench regions [size]       reachability: BFS per query vs region labels, edit relabel cost
+//   map_bench autotile [size]      deco autotile masks: load sweep, per-edit update, and a view
+//                                  drawn from masks vs neighbor reads per frame
+//   map_bench gen [size]           procedural generation over 1..N threads; output must not change
+//   map_bench layout [height]      packed scans on a 2048-wide map in the compiled layout;
+//                                  run from a default and a LAYOUT=blocked build to compare
+//   map_bench door a.map3 b.map3   door trip frame cost: synchronous load, background preload,
+//                                  map cache
+#if defined(__linux__)
+#define _DEFAULT_SOURCE
+#endif
+
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "world/autotile.h"
+#include "world/coll_rects.h"
+#include "world/layered_map.h"
+#include "world/map_cache.h"
+#include "world/map_gen.h"
+#include "world/map_preload.h"
+#include "world/map_regions.h"
+#include "world/map_text.h"
+#include "world/tile_props.h"
+
+static double now_sec(void)
+{
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+// ---------- Cache-miss counter (Linux perf events; -1 when unavailable) ----------
+
+static int perf_open_cache_misses(void)
+{
+#if defined(__linux__)
+    struct perf_event_attr a;
+    memset(&a, 0, sizeof(a));
+    a.size = sizeof(a);
+    a.type = PERF_TYPE_HARDWARE;
+    a.config = PERF_COUNT_HW_CACHE_MISSES;
+    a.disabled = 1;
+    a.exclude_kernel = 1;
+    a.exclude_hv = 1;
+    return (int)syscall(SYS_perf_event_open, &a, 0, -1, -1, 0);
+#else
+    return -1;
+#endif
+}
+
+static void perf_start(int fd)
+{
+#if defined(__linux__)
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#else
+    (void)fd;
+#endif
+}
+
+static long long perf_stop(int fd)
+{
+#if defined(__linux__)
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long v = 0;
+    if (read(fd, &v, sizeof(v)) != (ssize_t)sizeof(v)) return -1;
+    return v;
+#else
+    (void)fd;
+    return -1;
+#endif
+}
+
+// ---------- Synthetic maps ----------
+
+typedef struct TextBuf
+{
+    char*  data;
+    size_t len;
+    size_t cap;
+} TextBuf;
+
+static bool tb_reserve(TextBuf* b, size_t extra)
+{
+    if (b->len + extra <= b->cap) return true;
+    size_t cap = b->cap ? b->cap : 4096;
+    while (cap < b->len + extra) cap *= 2;
+    char* p = (char*)realloc(b->data, cap);
+    if (!p) return false;
+    b->data = p;
+    b->cap = cap;
+    return true;
+}
+
+static void tb_puts(TextBuf* b, const char* s)
+{
+    const size_t n = strlen(s);
+    if (!tb_reserve(b, n)) return;
+    memcpy(b->data + b->len, s, n);
+    b->len += n;
+}
+
+static uint32_t rng_next(uint32_t* s)
+{
+    // xorshift32; deterministic across runs
+    uint32_t x = *s;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *s = x;
+    return x;
+}
+
+// Mostly-grass ground with some variety, border walls, sparse deco/interact.
+static int synth_value(int layer, int x, int y, int w, int h, uint32_t* seed)
+{
+    const bool border = (x == 0 || y == 0 || x == w - 1 || y == h - 1);
+    const uint32_t r = rng_next(seed);
+    switch (layer)
+    {
+        case MAP_LAYER_GROUND:   return (r % 16 == 0) ? (int)(2 + r % 30) : 1;
+        case MAP_LAYER_DECO:     return border ? 3 : ((r % 64 == 0) ? (int)(4 + r % 8) : 0);
+        case MAP_LAYER_COLL:     return border ? 1 : ((r % 64 == 0) ? 1 : 0);
+        case MAP_LAYER_INTERACT: return (r % 1024 == 0) ? (int)(1 + r % 3) : 0;
+    }
+    return 0;
+}
+
+static uint32_t synth_seed(int w, int h)
+{
+    return 0x9E3779B9u ^ (uint32_t)(w * 31 + h);
+}
+
+// Same content as build_synthetic, filled straight into a dense map.
+static bool fill_synthetic(LayeredMap* m, int w, int h)
+{
+    if (!LayeredMap_Init(m, w, h, 32)) return false;
+
+    int* layers[MAP_LAYER_COUNT] = { m->ground, m->deco, m->coll, m->interact };
+    uint32_t seed = synth_seed(w, h);
+    for (int l = 0; l < MAP_LAYER_COUNT; ++l)
+        for (int y = 0; y < h; ++y)
+            for (int x = 0; x < w; ++x)
+                layers[l][y * w + x] = synth_value(l, x, y, w, h, &seed);
+    return true;
+}
+
+static bool build_synthetic(TextBuf* b, int w, int h)
+{
+    char line[64];
+    uint32_t seed = synth_seed(w, h);
+
+    b->len = 0;
+    snprintf(line, sizeof(line), "MAP3 %d %d 32\n", w, h);
+    tb_puts(b, line);
+
+    static const char* sections[4] = { "GROUND", "DECO", "COLL", "INTERACT" };
+    for (int s = 0; s < 4; ++s)
+    {
+        tb_puts(b, "\n");
+        tb_puts(b, sections[s]);
+        tb_puts(b, "\n");
+
+        if (!tb_reserve(b, (size_t)w * (size_t)h * 3)) return false;
+
+        for (int y = 0; y < h; ++y)
+        {
+            for (int x = 0; x < w; ++x)
+            {
+                const int v = synth_value(s, x, y, w, h, &seed);
+                // values stay below 100
+                if (v >= 10) b->data[b->len++] = (char)('0' + v / 10);
+                b->data[b->len++] = (char)('0' + v % 10);
+                b->data[b->len++] = (x + 1 < w) ? ' ' : '\n';
+            }
+        }
+    }
+    return true;
+}
+
+// ---------- Modes ----------
+
+static int bench_parse(int max_size)
+{
+    printf("%-11s %10s %10s %10s %12s\n", "size", "text MB", "ms", "MB/s", "Mtiles/s");
+
+    TextBuf b = { NULL, 0, 0 };
+    for (int size = 256; size <= max_size; size *= 2)
+    {
+        if (!build_synthetic(&b, size, size))
+        {
+            fprintf(stderr, "map_bench: out of memory building %dx%d\n", size, size);
+            free(b.data);
+            return 1;
+        }
+
+        // Best of a few runs; the big ones only once.
+        const int runs = (size <= 1024) ? 5 : 1;
+        double best = 1e30;
+
+        for (int i = 0; i < runs; ++i)
+        {
+            LayeredMap m;
+            memset(&m, 0, sizeof(m));
+
+            SDL_IOStream* io = SDL_IOFromConstMem(b.data, b.len);
+            const double t0 = now_sec();
+            const bool ok = MapText_Load(&m, io, "synthetic");
+            const double t1 = now_sec();
+            SDL_CloseIO(io);
+            LayeredMap_Shutdown(&m);
+
+            if (!ok)
+            {
+                fprintf(stderr, "map_bench: parse failed at %dx%d\n", size, size);
+                free(b.data);
+                return 1;
+            }
+            if (t1 - t0 < best) best = t1 - t0;
+        }
+
+        const double mb = (double)b.len / (1024.0 * 1024.0);
+        const double tiles = (double)size * (double)size;
+        char label[32];
+        snprintf(label, sizeof(label), "%dx%d", size, size);
+        printf("%-11s %10.1f %10.2f %10.1f %12.2f\n",
+               label, mb, best * 1000.0, mb / best, tiles / best / 1e6);
+    }
+
+    free(b.data);
+    return 0;
+}
+
+static int bench_files(int argc, char** argv)
+{
+    int failed = 0;
+    for (int i = 0; i < argc; ++i)
+    {
+        LayeredMap m;
+        memset(&m, 0, sizeof(m));
+
+        const double t0 = now_sec();
+        const bool ok = LayeredMap_LoadFromFile(&m, argv[i]);
+        const double t1 = now_sec();
+
+        if (ok)
+            printf("%s: %dx%d in %.3f ms (%s), %zu KiB, sparse deco/interact: %s/%s\n",
+                   argv[i], m.width, m.height, (t1 - t0) * 1000.0,
+                   m.backing ? "compiled" : "text", LayeredMap_MemoryBytes(&m) / 1024,
+                   m.deco_sparse ? "yes" : "no", m.interact_sparse ? "yes" : "no");
+        else
+            failed++;
+
+        LayeredMap_Shutdown(&m);
+    }
+    return failed ? 1 : 0;
+}
+
+// ---------- Access patterns ----------
+
+typedef struct ScanResult
+{
+    double ns_per_tile;
+    double misses_per_ktile; // < 0 when counters are unavailable
+    long long checksum;
+} ScanResult;
+
+// What Game_Render does per frame: ground, deco and wall passes over a
+// 1280x720 view of 32px tiles, at camera positions scattered over the map.
+static ScanResult scan_render(const LayeredMap* m, int frames, int perf_fd)
+{
+    const int vw = 41, vh = 24;
+    uint32_t seed = 12345u;
+    long long sum = 0, tiles = 0;
+
+    perf_start(perf_fd);
+    const double t0 = now_sec();
+    for (int f = 0; f < frames; ++f)
+    {
+        const int tx0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->width - vw));
+        const int ty0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->height - vh));
+
+        for (int ty = ty0; ty < ty0 + vh; ++ty)
+            for (int tx = tx0; tx < tx0 + vw; ++tx)
+                sum += LayeredMap_Ground(m, tx, ty);
+        for (int ty = ty0; ty < ty0 + vh; ++ty)
+            for (int tx = tx0; tx < tx0 + vw; ++tx)
+                sum += LayeredMap_Deco(m, tx, ty);
+        for (int ty = ty0; ty < ty0 + vh; ++ty)
+            for (int tx = tx0; tx < tx0 + vw; ++tx)
+                if (LayeredMap_Solid(m, tx, ty) && LayeredMap_Deco(m, tx, ty) == 0) sum++;
+
+        tiles += (long long)vw * vh;
+    }
+    const double t1 = now_sec();
+    const long long misses = perf_stop(perf_fd);
+
+    ScanResult r;
+    r.ns_per_tile = (t1 - t0) * 1e9 / (double)tiles;
+    r.misses_per_ktile = misses < 0 ? -1.0 : (double)misses * 1000.0 / (double)tiles;
+    r.checksum = sum;
+    return r;
+}
+
+// What Collision_MoveBox_Tiles does: small (1-3 tile) boxes probed with
+// LayeredMap_Solid, for many movers spread over the map.
+static ScanResult scan_collision(const LayeredMap* m, int boxes, int perf_fd)
+{
+    uint32_t seed = 777u;
+    long long sum = 0, tiles = 0;
+
+    perf_start(perf_fd);
+    const double t0 = now_sec();
+    for (int i = 0; i < boxes; ++i)
+    {
+        const int bw = 1 + (int)(rng_next(&seed) % 3);
+        const int bh = 1 + (int)(rng_next(&seed) % 3);
+        const int tx0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->width - bw));
+        const int ty0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->height - bh));
+
+        for (int ty = ty0; ty < ty0 + bh; ++ty)
+            for (int tx = tx0; tx < tx0 + bw; ++tx)
+                sum += LayeredMap_Solid(m, tx, ty);
+
+        tiles += (long long)bw * bh;
+    }
+    const double t1 = now_sec();
+    const long long misses = perf_stop(perf_fd);
+
+    ScanResult r;
+    r.ns_per_tile = (t1 - t0) * 1e9 / (double)tiles;
+    r.misses_per_ktile = misses < 0 ? -1.0 : (double)misses * 1000.0 / (double)tiles;
+    r.checksum = sum;
+    return r;
+}
+
+// scan_render through LayeredMap_Row, as Game_Render now reads the map.
+static ScanResult scan_render_span(const LayeredMap* m, int frames, int perf_fd)
+{
+    const int vw = 41, vh = 24;
+    int gbuf[41], dbuf[41], cbuf[41];
+    uint32_t seed = 12345u;
+    long long sum = 0, tiles = 0;
+
+    perf_start(perf_fd);
+    const double t0 = now_sec();
+    for (int f = 0; f < frames; ++f)
+    {
+        int tx0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->width - vw));
+        int ty0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->height - vh));
+        int tx1 = tx0 + vw, ty1 = ty0 + vh;
+        if (!LayeredMap_ClipRect(m, &tx0, &ty0, &tx1, &ty1)) continue;
+        const int n = tx1 - tx0;
+
+        for (int ty = ty0; ty < ty1; ++ty)
+        {
+            const int* row = LayeredMap_Row(m, MAP_LAYER_GROUND, tx0, ty, n, gbuf);
+            for (int i = 0; i < n; ++i) sum += row[i];
+        }
+        for (int ty = ty0; ty < ty1; ++ty)
+        {
+            const int* row = LayeredMap_Row(m, MAP_LAYER_DECO, tx0, ty, n, dbuf);
+            for (int i = 0; i < n; ++i) sum += row[i];
+        }
+        for (int ty = ty0; ty < ty1; ++ty)
+        {
+            const int* solid = LayeredMap_Row(m, MAP_LAYER_COLL, tx0, ty, n, cbuf);
+            const int* deco = LayeredMap_Row(m, MAP_LAYER_DECO, tx0, ty, n, dbuf);
+            for (int i = 0; i < n; ++i)
+                if (solid[i] && deco[i] == 0) sum++;
+        }
+
+        tiles += (long long)vw * vh;
+    }
+    const double t1 = now_sec();
+    const long long misses = perf_stop(perf_fd);
+
+    ScanResult r;
+    r.ns_per_tile = (t1 - t0) * 1e9 / (double)tiles;
+    r.misses_per_ktile = misses < 0 ? -1.0 : (double)misses * 1000.0 / (double)tiles;
+    r.checksum = sum;
+    return r;
+}
+
+// scan_collision through LayeredMap_Row, as collision.c now probes boxes.
+static ScanResult scan_collision_span(const LayeredMap* m, int boxes, int perf_fd)
+{
+    uint32_t seed = 777u;
+    long long sum = 0, tiles = 0;
+
+    perf_start(perf_fd);
+    const double t0 = now_sec();
+    for (int i = 0; i < boxes; ++i)
+    {
+        const int bw = 1 + (int)(rng_next(&seed) % 3);
+        const int bh = 1 + (int)(rng_next(&seed) % 3);
+        const int tx0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->width - bw));
+        const int ty0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, m->height - bh));
+
+        int buf[3];
+        for (int ty = ty0; ty < ty0 + bh; ++ty)
+        {
+            const int* row = LayeredMap_Row(m, MAP_LAYER_COLL, tx0, ty, bw, buf);
+            for (int k = 0; k < bw; ++k) sum += row[k];
+        }
+        tiles += (long long)bw * bh;
+    }
+    const double t1 = now_sec();
+    const long long misses = perf_stop(perf_fd);
+
+    ScanResult r;
+    r.ns_per_tile = (t1 - t0) * 1e9 / (double)tiles;
+    r.misses_per_ktile = misses < 0 ? -1.0 : (double)misses * 1000.0 / (double)tiles;
+    r.checksum = sum;
+    return r;
+}
+
+// What find_nearby_interact does: the player's tile and its 4 neighbors.
+static ScanResult scan_interact(const LayeredMap* m, int probes, int perf_fd)
+{
+    static const int off[5][2] = { {0,0},{1,0},{-1,0},{0,1},{0,-1} };
+    uint32_t seed = 4242u;
+    long long sum = 0;
+
+    perf_start(perf_fd);
+    const double t0 = now_sec();
+    for (int i = 0; i < probes; ++i)
+    {
+        const int px = (int)(rng_next(&seed) % (uint32_t)m->width);
+        const int py = (int)(rng_next(&seed) % (uint32_t)m->height);
+        for (int k = 0; k < 5; ++k)
+            sum += LayeredMap_Interact(m, px + off[k][0], py + off[k][1]);
+    }
+    const double t1 = now_sec();
+    const long long misses = perf_stop(perf_fd);
+
+    const double tiles = (double)probes * 5.0;
+    ScanResult r;
+    r.ns_per_tile = (t1 - t0) * 1e9 / tiles;
+    r.misses_per_ktile = misses < 0 ? -1.0 : (double)misses * 1000.0 / tiles;
+    r.checksum = sum;
+    return r;
+}
+
+static void print_scan(const char* label, ScanResult r)
+{
+    if (r.misses_per_ktile < 0)
+        printf("  %-22s %8.2f ns/tile   cache misses n/a\n", label, r.ns_per_tile);
+    else
+        printf("  %-22s %8.2f ns/tile   %8.1f misses/1k tiles\n", label, r.ns_per_tile, r.misses_per_ktile);
+}
+
+static int bench_packed(int size)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!fill_synthetic(&m, size, size))
+    {
+        fprintf(stderr, "map_bench: out of memory for %dx%d\n", size, size);
+        return 1;
+    }
+
+    const int perf_fd = perf_open_cache_misses();
+    if (perf_fd < 0) printf("(hardware cache-miss counter unavailable)\n");
+
+    const int frames = 2000;
+    const int boxes = 2000000;
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1 && !LayeredMap_Pack(&m))
+        {
+            fprintf(stderr, "map_bench: LayeredMap_Pack failed\n");
+            break;
+        }
+
+        const size_t bytes = LayeredMap_MemoryBytes(&m);
+        printf("%s %dx%d: %.1f MiB (%.2f bytes/tile)\n",
+               pass == 0 ? "dense " : "packed", size, size,
+               (double)bytes / (1024.0 * 1024.0), (double)bytes / ((double)size * size));
+
+        const ScanResult rr = scan_render(&m, frames, perf_fd);
+        const ScanResult rc = scan_collision(&m, boxes, perf_fd);
+        print_scan("render (visible rect)", rr);
+        print_scan("collision (boxes)", rc);
+        printf("  checksum %lld/%lld\n", rr.checksum, rc.checksum);
+    }
+
+#if defined(__linux__)
+    if (perf_fd >= 0) close(perf_fd);
+#endif
+    LayeredMap_Shutdown(&m);
+    return 0;
+}
+
+static int bench_span(int size)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!fill_synthetic(&m, size, size))
+    {
+        fprintf(stderr, "map_bench: out of memory for %dx%d\n", size, size);
+        return 1;
+    }
+
+    const int perf_fd = perf_open_cache_misses();
+    if (perf_fd < 0) printf("(hardware cache-miss counter unavailable)\n");
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1 && !LayeredMap_Pack(&m))
+        {
+            fprintf(stderr, "map_bench: LayeredMap_Pack failed\n");
+            break;
+        }
+        printf("%s %dx%d\n", pass == 0 ? "dense " : "packed", size, size);
+
+        const ScanResult rt = scan_render(&m, 2000, perf_fd);
+        const ScanResult rs = scan_render_span(&m, 2000, perf_fd);
+        const ScanResult ct = scan_collision(&m, 2000000, perf_fd);
+        const ScanResult cs = scan_collision_span(&m, 2000000, perf_fd);
+        print_scan("render, per tile", rt);
+        print_scan("render, row spans", rs);
+        print_scan("collision, per tile", ct);
+        print_scan("collision, row spans", cs);
+        if (rt.checksum != rs.checksum || ct.checksum != cs.checksum)
+            printf("  CHECKSUM MISMATCH %lld/%lld %lld/%lld\n", rt.checksum, rs.checksum, ct.checksum, cs.checksum);
+    }
+
+#if defined(__linux__)
+    if (perf_fd >= 0) close(perf_fd);
+#endif
+    LayeredMap_Shutdown(&m);
+    return 0;
+}
+
+// ---------- Edits ----------
+
+// Stand-in for data derived from the map: solid tiles per chunk.
+static void count_chunk(const LayeredMap* m, int* counts, int chunks_w, int cx, int cy)
+{
+    int tx0 = cx * LAYERED_MAP_CHUNK, ty0 = cy * LAYERED_MAP_CHUNK;
+    int tx1 = tx0 + LAYERED_MAP_CHUNK, ty1 = ty0 + LAYERED_MAP_CHUNK;
+    int buf[LAYERED_MAP_CHUNK];
+    int n = 0;
+
+    if (LayeredMap_ClipRect(m, &tx0, &ty0, &tx1, &ty1))
+    {
+        for (int ty = ty0; ty < ty1; ++ty)
+        {
+            const int* row = LayeredMap_Row(m, MAP_LAYER_COLL, tx0, ty, tx1 - tx0, buf);
+            for (int i = 0; i < tx1 - tx0; ++i) n += row[i];
+        }
+    }
+    counts[cy * chunks_w + cx] = n;
+}
+
+static void count_all(const LayeredMap* m, int* counts, int chunks_w, int chunks_h)
+{
+    for (int cy = 0; cy < chunks_h; ++cy)
+        for (int cx = 0; cx < chunks_w; ++cx)
+            count_chunk(m, counts, chunks_w, cx, cy);
+}
+
+static int bench_edit(int size)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!fill_synthetic(&m, size, size) || !LayeredMap_Pack(&m))
+    {
+        fprintf(stderr, "map_bench: cannot build packed %dx%d\n", size, size);
+        LayeredMap_Shutdown(&m);
+        return 1;
+    }
+
+    const int chunks_w = (size + LAYERED_MAP_CHUNK - 1) / LAYERED_MAP_CHUNK;
+    const int chunks_h = chunks_w;
+    int* counts = (int*)calloc((size_t)chunks_w * chunks_h, sizeof(int));
+    int* check = (int*)calloc((size_t)chunks_w * chunks_h, sizeof(int));
+    LayeredMapEdit* edits = (LayeredMapEdit*)malloc(sizeof(LayeredMapEdit) * LAYERED_MAP_JOURNAL_CAP);
+    if (!counts || !check || !edits)
+    {
+        fprintf(stderr, "map_bench: out of memory\n");
+        free(counts); free(check); free(edits);
+        LayeredMap_Shutdown(&m);
+        return 1;
+    }
+
+    double t0 = now_sec();
+    count_all(&m, counts, chunks_w, chunks_h);
+    const double full_ms = (now_sec() - t0) * 1000.0;
+    printf("packed %dx%d, %d chunks; full rebuild of per-chunk solid counts: %.3f ms\n",
+           size, size, chunks_w * chunks_h, full_ms);
+    printf("%-22s %9s %10s %8s %9s %12s\n", "batch", "edits", "ns/edit", "chunks", "journal", "update ms");
+
+    static const struct { const char* name; int edits; int brush; } batches[] = {
+        { "scattered 100",        100,     0 },
+        { "scattered 4k",         4000,    0 },
+        { "scattered 1M",         1000000, 0 },
+        { "brush 64x64",          0,       64 },
+        { "brush 512x512",        0,       512 },
+    };
+
+    uint32_t seed = 99u;
+    uint64_t since = LayeredMap_EditSeq(&m);
+    int mismatches = 0;
+
+    for (size_t b = 0; b < sizeof(batches) / sizeof(batches[0]); ++b)
+    {
+        const uint64_t seq0 = LayeredMap_EditSeq(&m);
+
+        t0 = now_sec();
+        if (batches[b].brush == 0)
+        {
+            for (int i = 0; i < batches[b].edits; ++i)
+            {
+                const int tx = (int)(rng_next(&seed) % (uint32_t)size);
+                const int ty = (int)(rng_next(&seed) % (uint32_t)size);
+                LayeredMap_SetSolid(&m, tx, ty, rng_next(&seed) & 1u);
+                LayeredMap_SetGround(&m, tx, ty, 1 + (int)(rng_next(&seed) % 30));
+            }
+        }
+        else
+        {
+            const int bs = batches[b].brush;
+            const int x0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, size - bs));
+            const int y0 = (int)(rng_next(&seed) % (uint32_t)SDL_max(1, size - bs));
+            const bool solid = (b & 1u) != 0;
+            for (int ty = y0; ty < y0 + bs; ++ty)
+                for (int tx = x0; tx < x0 + bs; ++tx)
+                    LayeredMap_SetSolid(&m, tx, ty, solid);
+        }
+        const double edit_s = now_sec() - t0;
+        const uint64_t made = LayeredMap_EditSeq(&m) - seq0;
+
+        // Incremental: recount dirty chunks, drain the journal.
+        t0 = now_sec();
+        int dirty = 0, cx, cy;
+        while (LayeredMap_TakeDirtyChunk(&m, &cx, &cy))
+        {
+            count_chunk(&m, counts, chunks_w, cx, cy);
+            dirty++;
+        }
+        int journal = 0, got;
+        while ((got = LayeredMap_ReadJournal(&m, &since, edits, LAYERED_MAP_JOURNAL_CAP)) > 0)
+            journal += got;
+        const double update_ms = (now_sec() - t0) * 1000.0;
+
+        count_all(&m, check, chunks_w, chunks_h);
+        if (memcmp(counts, check, sizeof(int) * (size_t)chunks_w * chunks_h) != 0) mismatches++;
+
+        char jtext[24];
+        if (got < 0) snprintf(jtext, sizeof(jtext), "overflow");
+        else snprintf(jtext, sizeof(jtext), "%d", journal);
+        printf("%-22s %9llu %10.1f %8d %9s %12.3f\n", batches[b].name, (unsigned long long)made,
+               made ? edit_s * 1e9 / (double)made : 0.0, dirty, jtext, update_ms);
+    }
+
+    if (mismatches) printf("INCREMENTAL MISMATCH in %d batches\n", mismatches);
+
+    free(counts);
+    free(check);
+    free(edits);
+    LayeredMap_Shutdown(&m);
+    return mismatches ? 1 : 0;
+}
+
+// ---------- Rect queries ----------
+
+// The loop version: rect_collides_tiles / first_solid over row spans.
+static bool rect_any_solid_loop(const LayeredMap* m, int tx0, int ty0, int tx1, int ty1)
+{
+    int buf[LAYERED_MAP_SPAN_MAX];
+    for (int ty = ty0; ty < ty1; ++ty)
+    {
+        for (int x = tx0; x < tx1; x += LAYERED_MAP_SPAN_MAX)
+        {
+            const int count = SDL_min(tx1 - x, LAYERED_MAP_SPAN_MAX);
+            const int* row = LayeredMap_Row(m, MAP_LAYER_COLL, x, ty, count, buf);
+            for (int i = 0; i < count; ++i)
+                if (row[i]) return true;
+        }
+    }
+    return false;
+}
+
+static int bench_rect(int size)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!fill_synthetic(&m, size, size) || !LayeredMap_Pack(&m))
+    {
+        fprintf(stderr, "map_bench: cannot build packed %dx%d\n", size, size);
+        LayeredMap_Shutdown(&m);
+        return 1;
+    }
+    // Clear some open areas so larger rects are not all trivially blocked
+    // after their first row.
+    uint32_t seed = 5u;
+    for (int k = 0; k < size / 8; ++k)
+    {
+        const int x0 = (int)(rng_next(&seed) % (uint32_t)size);
+        const int y0 = (int)(rng_next(&seed) % (uint32_t)size);
+        for (int ty = y0; ty < y0 + 48; ++ty)
+            for (int tx = x0; tx < x0 + 48; ++tx)
+                LayeredMap_SetSolid(&m, tx, ty, false);
+    }
+
+    const size_t before = LayeredMap_MemoryBytes(&m);
+    double t0 = now_sec();
+    if (!LayeredMap_BuildCollTable(&m))
+    {
+        fprintf(stderr, "map_bench: LayeredMap_BuildCollTable failed\n");
+        LayeredMap_Shutdown(&m);
+        return 1;
+    }
+    const double build_ms = (now_sec() - t0) * 1000.0;
+    printf("packed %dx%d: table built in %.2f ms, +%.1f MiB\n", size, size, build_ms,
+           (double)(LayeredMap_MemoryBytes(&m) - before) / (1024.0 * 1024.0));
+
+    // Refresh cost after one edit, worst (top-left) and best (bottom-right) case
+    const int corners[2][2] = { { 0, 0 }, { size - 1, size - 1 } };
+    for (int c = 0; c < 2; ++c)
+    {
+        const int tx = corners[c][0], ty = corners[c][1];
+        LayeredMap_SetSolid(&m, tx, ty, !LayeredMap_Solid(&m, tx, ty));
+        t0 = now_sec();
+        (void)LayeredMap_SolidCount(&m, 0, 0, 1, 1);
+        printf("  refresh after edit at (%d,%d): %.3f ms\n", tx, ty, (now_sec() - t0) * 1000.0);
+    }
+
+    printf("%-8s %14s %14s %14s %14s\n", "rect", "any: loop", "any: table", "count: loop", "count: table");
+
+    const int queries = 200000;
+    for (int side = 1; side <= 64; side *= 2)
+    {
+        double t_loop = 0, t_any = 0, t_cloop = 0, t_count = 0;
+        long long hits_loop = 0, hits_any = 0, sum_loop = 0, sum_count = 0;
+
+        for (int pass = 0; pass < 4; ++pass)
+        {
+            uint32_t qs = 1000u + (uint32_t)side;
+            const double a = now_sec();
+            for (int q = 0; q < queries; ++q)
+            {
+                const int x = (int)(rng_next(&qs) % (uint32_t)(size - side));
+                const int y = (int)(rng_next(&qs) % (uint32_t)(size - side));
+                switch (pass)
+                {
+                case 0: hits_loop += rect_any_solid_loop(&m, x, y, x + side, y + side); break;
+                case 1: hits_any += !LayeredMap_RectClear(&m, x, y, x + side, y + side); break;
+                case 2:
+                {
+                    int buf[64], n = 0;
+                    for (int ty = y; ty < y + side; ++ty)
+                    {
+                        const int* row = LayeredMap_Row(&m, MAP_LAYER_COLL, x, ty, side, buf);
+                        for (int i = 0; i < side; ++i) n += row[i];
+                    }
+                    sum_loop += n;
+                    break;
+                }
+                case 3: sum_count += LayeredMap_SolidCount(&m, x, y, x + side, y + side); break;
+                }
+            }
+            const double dt = (now_sec() - a) * 1e9 / queries;
+            if (pass == 0) t_loop = dt;
+            else if (pass == 1) t_any = dt;
+            else if (pass == 2) t_cloop = dt;
+            else t_count = dt;
+        }
+
+        char label[16];
+        snprintf(label, sizeof(label), "%dx%d", side, side);
+        printf("%-8s %11.1f ns %11.1f ns %11.1f ns %11.1f ns%s\n", label, t_loop, t_any, t_cloop, t_count,
+               (hits_loop != hits_any || sum_loop != sum_count) ? "  MISMATCH" : "");
+    }
+
+    LayeredMap_Shutdown(&m);
+    return 0;
+}
+
+// ---------- Collision rects ----------
+
+// Wall-heavy map: 24x24 rooms with 1-tile walls and a 2-tile doorway per wall.
+static bool fill_rooms(LayeredMap* m, int size)
+{
+    if (!LayeredMap_Init(m, size, size, 32)) return false;
+    for (int y = 0; y < size; ++y)
+    {
+        for (int x = 0; x < size; ++x)
+        {
+            const int rx = x % 24, ry = y % 24;
+            const bool wall = (rx == 0 || ry == 0 || x == size - 1 || y == size - 1) &&
+                              !(rx == 0 && (ry == 11 || ry == 12)) && !(ry == 0 && (rx == 11 || rx == 12));
+            m->coll[y * size + x] = wall;
+            m->ground[y * size + x] = 1;
+        }
+    }
+    return true;
+}
+
+static bool count_rect(void* user, const CollRect* r)
+{
+    (void)r;
+    (*(int*)user)++;
+    return true;
+}
+
+static void bench_rects_on(const char* label, LayeredMap* m)
+{
+    long long solid = 0;
+    for (int y = 0; y < m->height; ++y)
+        for (int x = 0; x < m->width; ++x)
+            solid += LayeredMap_Solid(m, x, y);
+
+    double t0 = now_sec();
+    if (!LayeredMap_BakeCollRects(m))
+    {
+        printf("%s: bake failed\n", label);
+        return;
+    }
+    const double bake_ms = (now_sec() - t0) * 1000.0;
+    const CollRects* rects = LayeredMap_CollRects(m);
+
+    printf("%s %dx%d: %lld solid tiles -> %d rects (%.1fx), bake %.2f ms, %zu KiB\n",
+           label, m->width, m->height, solid, rects->count,
+           rects->count ? (double)solid / rects->count : 0.0, bake_ms, CollRects_MemoryBytes(rects) / 1024);
+
+    // Debug overlay: draw calls per 41x24 view, tiles vs rects
+    const int vw = SDL_min(41, m->width), vh = SDL_min(24, m->height);
+    uint32_t seed = 321u;
+    long long tile_draws = 0, rect_draws = 0;
+    const int views = 1000;
+    for (int v = 0; v < views; ++v)
+    {
+        const int x0 = (int)(rng_next(&seed) % (uint32_t)(m->width - vw + 1));
+        const int y0 = (int)(rng_next(&seed) % (uint32_t)(m->height - vh + 1));
+        tile_draws += LayeredMap_SolidCount(m, x0, y0, x0 + vw, y0 + vh);
+        int n = 0;
+        CollRects_Visit(rects, x0, y0, x0 + vw, y0 + vh, count_rect, &n);
+        rect_draws += n;
+    }
+    printf("  overlay draw calls per view: %.1f tiles -> %.1f rects\n",
+           (double)tile_draws / views, (double)rect_draws / views);
+
+    // "Any solid in box?" for the player's feet box (1x1..2x2) and 3x3 boxes
+    for (int side = 1; side <= 3; side += 2)
+    {
+        const int queries = 1000000;
+        double t_rows = 0, t_rects = 0;
+        long long h_rows = 0, h_rects = 0;
+        for (int pass = 0; pass < 2; ++pass)
+        {
+            uint32_t qs = 77u + (uint32_t)side;
+            const double a = now_sec();
+            for (int q = 0; q < queries; ++q)
+            {
+                const int bw = side == 1 ? 1 + (int)(rng_next(&qs) & 1u) : side;
+                const int x = (int)(rng_next(&qs) % (uint32_t)(m->width - bw + 1));
+                const int y = (int)(rng_next(&qs) % (uint32_t)(m->height - bw + 1));
+                if (pass == 0) h_rows += rect_any_solid_loop(m, x, y, x + bw, y + bw);
+                else h_rects += CollRects_Any(rects, x, y, x + bw, y + bw);
+            }
+            const double dt = (now_sec() - a) * 1e9 / queries;
+            if (pass == 0) t_rows = dt;
+            else t_rects = dt;
+        }
+        printf("  %s boxes: rows %.1f ns, rects %.1f ns%s\n", side == 1 ? "feet" : "3x3 ",
+               t_rows, t_rects, h_rows != h_rects ? "  MISMATCH" : "");
+    }
+}
+
+static int bench_rects(int size, int nfiles, char** files)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+
+    if (fill_rooms(&m, size) && LayeredMap_Pack(&m)) bench_rects_on("rooms", &m);
+    LayeredMap_Shutdown(&m);
+
+    if (fill_synthetic(&m, size, size) && LayeredMap_Pack(&m)) bench_rects_on("noisy", &m);
+    LayeredMap_Shutdown(&m);
+
+    for (int i = 0; i < nfiles; ++i)
+    {
+        if (LayeredMap_LoadFromFile(&m, files[i]) && LayeredMap_Pack(&m)) bench_rects_on(files[i], &m);
+        LayeredMap_Shutdown(&m);
+    }
+    return 0;
+}
+
+// ---------- Reachability ----------
+
+// The search a reachability query would otherwise run: BFS over walkable tiles.
+static bool bfs_reachable(const LayeredMap* m, int ax, int ay, int bx, int by, uint32_t* seen, uint32_t stamp, int* queue)
+{
+    if (LayeredMap_Solid(m, ax, ay) || LayeredMap_Solid(m, bx, by)) return false;
+
+    const int w = m->width;
+    int head = 0, tail = 0;
+    queue[tail++] = ay * w + ax;
+    seen[ay * w + ax] = stamp;
+    while (head < tail)
+    {
+        const int t = queue[head++];
+        const int x = t % w, y = t / w;
+        if (x == bx && y == by) return true;
+
+        const int nx[4] = { x, x + 1, x, x - 1 }, ny[4] = { y - 1, y, y + 1, y };
+        for (int k = 0; k < 4; ++k)
+        {
+            if (LayeredMap_Solid(m, nx[k], ny[k])) continue;   // outside counts as solid
+            const int n = ny[k] * w + nx[k];
+            if (seen[n] == stamp) continue;
+            seen[n] = stamp;
+            queue[tail++] = n;
+        }
+    }
+    return false;
+}
+
+static void bench_regions_on(const char* label, LayeredMap* m)
+{
+    const int n = m->width * m->height;
+    double t0 = now_sec();
+    if (!LayeredMap_BuildRegions(m))
+    {
+        printf("%s: build failed\n", label);
+        return;
+    }
+    printf("%s %dx%d: %d regions, labeled in %.2f ms, %zu KiB\n", label, m->width, m->height,
+           m->regions->regions, (now_sec() - t0) * 1000.0, MapRegions_MemoryBytes(m->regions) / 1024);
+
+    uint32_t* seen = (uint32_t*)SDL_calloc((size_t)n, sizeof(uint32_t));
+    int* queue = (int*)SDL_malloc(sizeof(int) * (size_t)n);
+    if (!seen || !queue)
+    {
+        SDL_free(seen);
+        SDL_free(queue);
+        return;
+    }
+
+    // Random pairs: BFS is slow, so it gets far fewer queries
+    const int bfs_queries = 200, label_queries = 1000000;
+    uint32_t qs = 99u;
+    int mismatch = 0, reachable = 0;
+    t0 = now_sec();
+    for (int q = 0; q < bfs_queries; ++q)
+    {
+        const int ax = (int)(rng_next(&qs) % (uint32_t)m->width), ay = (int)(rng_next(&qs) % (uint32_t)m->height);
+        const int bx = (int)(rng_next(&qs) % (uint32_t)m->width), by = (int)(rng_next(&qs) % (uint32_t)m->height);
+        const bool r = bfs_reachable(m, ax, ay, bx, by, seen, (uint32_t)q + 1u, queue);
+        reachable += r;
+        mismatch += r != LayeredMap_Reachable(m, ax, ay, bx, by);
+    }
+    const double t_bfs = (now_sec() - t0) * 1e6 / bfs_queries;
+
+    long long hits = 0;
+    t0 = now_sec();
+    for (int q = 0; q < label_queries; ++q)
+    {
+        const int ax = (int)(rng_next(&qs) % (uint32_t)m->width), ay = (int)(rng_next(&qs) % (uint32_t)m->height);
+        const int bx = (int)(rng_next(&qs) % (uint32_t)m->width), by = (int)(rng_next(&qs) % (uint32_t)m->height);
+        hits += LayeredMap_Reachable(m, ax, ay, bx, by);
+    }
+    const double t_label = (now_sec() - t0) * 1e9 / label_queries;
+    printf("  reachable?  BFS %.1f us, labels %.1f ns  (%d/%d reachable)%s\n", t_bfs, t_label,
+           reachable, bfs_queries, mismatch ? "  MISMATCH" : "");
+    (void)hits;
+
+    // Close then reopen random walkable tiles: relabel cost per edit vs a full relabel
+    const int edits = 2000;
+    double worst = 0, total = 0;
+    int done = 0;
+    for (int e = 0; e < edits; ++e)
+    {
+        const int x = (int)(rng_next(&qs) % (uint32_t)m->width), y = (int)(rng_next(&qs) % (uint32_t)m->height);
+        if (LayeredMap_Solid(m, x, y)) continue;
+        for (int k = 0; k < 2; ++k)
+        {
+            const double a = now_sec();
+            LayeredMap_SetSolid(m, x, y, k == 0);
+            const double dt = now_sec() - a;
+            total += dt;
+            worst = SDL_max(worst, dt);
+            done++;
+        }
+    }
+    t0 = now_sec();
+    MapRegions* fresh = MapRegions_Build(m);
+    const double rebuild_ms = (now_sec() - t0) * 1000.0;
+    const bool same = fresh && m->regions && fresh->regions == m->regions->regions;
+    MapRegions_Destroy(fresh);
+    printf("  collision edit: %.2f us mean, %.1f us worst over %d edits; full relabel %.2f ms%s\n",
+           done ? total * 1e6 / done : 0.0, worst * 1e6, done, rebuild_ms, same ? "" : "  MISMATCH");
+
+    SDL_free(seen);
+    SDL_free(queue);
+}
+
+static int bench_regions(int size)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+
+    if (fill_rooms(&m, size) && LayeredMap_Pack(&m)) bench_regions_on("rooms", &m);
+    LayeredMap_Shutdown(&m);
+
+    if (fill_synthetic(&m, size, size) && LayeredMap_Pack(&m)) bench_regions_on("noisy", &m);
+    LayeredMap_Shutdown(&m);
+    return 0;
+}
+
+// ---------- Autotiling ----------
+
+// Ids drawn for a view row [x0, x0+w) of an interior view. Without masks
+// the renderer reads the rows above and below and compares neighbors.
+static long long autotile_view_row(const LayeredMap* m, const TileProps* p, int x0, int y, int w, bool masks)
+{
+    int above[64], row[64], below[64];
+    const int* mid = LayeredMap_Row(m, MAP_LAYER_DECO, x0 - 1, y, w + 2, row);
+    long long sum = 0;
+
+    if (masks)
+    {
+        const uint8_t* mask = Autotile_Row(m->autotile, x0, y);
+        for (int i = 0; i < w; ++i) sum += TileProps_AutotileId(p, mid[i + 1], mask[i]);
+        return sum;
+    }
+
+    const int* up = LayeredMap_Row(m, MAP_LAYER_DECO, x0, y - 1, w, above);
+    const int* down = LayeredMap_Row(m, MAP_LAYER_DECO, x0, y + 1, w, below);
+    for (int i = 0; i < w; ++i)
+    {
+        const int id = mid[i + 1];
+        const unsigned mask = (unsigned)(up[i] == id) | (unsigned)(mid[i + 2] == id) << 1 |
+                              (unsigned)(down[i] == id) << 2 | (unsigned)(mid[i] == id) << 3;
+        sum += TileProps_AutotileId(p, id, mask);
+    }
+    return sum;
+}
+
+static int bench_autotile(int size)
+{
+    static TileProps props;
+    TileProps_SetDefaults(&props);
+    props.autotile[3] = 100;   // walls
+    props.autotile[5] = 200;   // water edges
+    props.any_autotile = true;
+    TileProps_SetActive(&props);
+
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!fill_rooms(&m, size))
+    {
+        TileProps_SetActive(NULL);
+        return 1;
+    }
+    uint32_t seed = 17u;
+    for (int i = 0; i < size * size; ++i)
+    {
+        m.deco[i] = m.coll[i] ? 3 : 0;
+        if (!m.deco[i] && (rng_next(&seed) & 15u) == 0) m.deco[i] = 5;
+    }
+    (void)LayeredMap_Pack(&m);
+
+    double t0 = now_sec();
+    (void)LayeredMap_BuildAutotile(&m);
+    printf("packed %dx%d: masks in %.2f ms, %zu KiB\n", size, size, (now_sec() - t0) * 1000.0,
+           Autotile_MemoryBytes(m.autotile) / 1024);
+
+    const int edits = 100000;
+    t0 = now_sec();
+    for (int e = 0; e < edits; ++e)
+    {
+        const int x = (int)(rng_next(&seed) % (uint32_t)size), y = (int)(rng_next(&seed) % (uint32_t)size);
+        (void)LayeredMap_SetDeco(&m, x, y, (rng_next(&seed) & 1u) ? 3 : 0);
+    }
+    printf("  deco edit incl. 3x3 update: %.1f ns\n", (now_sec() - t0) * 1e9 / edits);
+
+    // One 41x24 view per frame
+    const int frames = 2000, vw = 41, vh = 24;
+    long long sum[2] = { 0, 0 };
+    double ns[2];
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        uint32_t vs = 5u;
+        t0 = now_sec();
+        for (int f = 0; f < frames; ++f)
+        {
+            const int x0 = 1 + (int)(rng_next(&vs) % (uint32_t)(size - vw - 2));
+            const int y0 = 1 + (int)(rng_next(&vs) % (uint32_t)(size - vh - 2));
+            for (int y = y0; y < y0 + vh; ++y)
+                sum[pass] += autotile_view_row(&m, &props, x0, y, vw, pass == 1);
+        }
+        ns[pass] = (now_sec() - t0) * 1e9 / ((double)frames * vw * vh);
+    }
+    printf("  view: neighbor reads %.1f ns/tile, masks %.1f ns/tile%s\n", ns[0], ns[1],
+           sum[0] != sum[1] ? "  MISMATCH" : "");
+
+    LayeredMap_Shutdown(&m);
+    TileProps_SetActive(NULL);
+    return sum[0] == sum[1] ? 0 : 1;
+}
+
+// ---------- Procedural generation ----------
+
+static uint64_t map_checksum(const LayeredMap* m)
+{
+    uint64_t h = 1469598103934665603ull;   // FNV-1a over all layers
+    const size_t n = (size_t)m->width * (size_t)m->height;
+    const int* layers[MAP_LAYER_COUNT] = { m->ground, m->deco, m->coll, m->interact };
+    for (int l = 0; l < MAP_LAYER_COUNT; ++l)
+        for (size_t i = 0; i < n; ++i)
+            h = (h ^ (uint32_t)layers[l][i]) * 1099511628211ull;
+    return h;
+}
+
+static int bench_gen(int size)
+{
+    MapGenParams p;
+    MapGen_DefaultParams(&p, 12345u, size, size);
+
+    const int cores = SDL_GetNumLogicalCPUCores();
+    uint64_t reference = 0;
+    double single_ms = 0.0;
+    bool same = true;
+
+    printf("generate %dx%d:\n", size, size);
+    for (int threads = 1;; threads = SDL_min(threads * 2, cores))
+    {
+        LayeredMap m;
+        memset(&m, 0, sizeof(m));
+        double best = 0.0;
+        uint64_t sum = 0;
+        for (int rep = 0; rep < 3; ++rep)
+        {
+            const double t0 = now_sec();
+            if (!MapGen_Generate(&m, &p, threads))
+            {
+                fprintf(stderr, "map_bench: MapGen_Generate failed\n");
+                return 1;
+            }
+            const double ms = (now_sec() - t0) * 1000.0;
+            if (rep == 0 || ms < best) best = ms;
+            sum = map_checksum(&m);
+            LayeredMap_Shutdown(&m);
+        }
+
+        if (threads == 1)
+        {
+            reference = sum;
+            single_ms = best;
+        }
+        same = same && sum == reference;
+        printf("  %2d threads: %8.1f ms (%.2fx)  checksum %016llx%s\n", threads, best, single_ms / best,
+               (unsigned long long)sum, sum == reference ? "" : "  MISMATCH");
+        if (threads >= cores) break;
+    }
+    return same ? 0 : 1;
+}
+
+static int bench_layout(int height)
+{
+    const int width = 2048;
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+    if (!fill_synthetic(&m, width, height) || !LayeredMap_Pack(&m))
+    {
+        fprintf(stderr, "map_bench: cannot build packed %dx%d\n", width, height);
+        LayeredMap_Shutdown(&m);
+        return 1;
+    }
+
+    const int perf_fd = perf_open_cache_misses();
+    if (perf_fd < 0) printf("(hardware cache-miss counter unavailable)\n");
+
+#if LAYERED_MAP_BLOCKED
+    printf("layout: %dx%d blocks", 1 << LAYERED_MAP_BLOCK_SHIFT, 1 << LAYERED_MAP_BLOCK_SHIFT);
+#else
+    printf("layout: row-major");
+#endif
+    printf(", packed %dx%d, %.1f MiB\n", width, height,
+           (double)LayeredMap_MemoryBytes(&m) / (1024.0 * 1024.0));
+
+    // Several rounds; the spread shows how much of a difference is noise.
+    for (int round = 0; round < 3; ++round)
+    {
+        const ScanResult rr = scan_render(&m, 2000, perf_fd);
+        const ScanResult rc = scan_collision(&m, 2000000, perf_fd);
+        const ScanResult ri = scan_interact(&m, 2000000, perf_fd);
+        print_scan("render (visible rect)", rr);
+        print_scan("collision (boxes)", rc);
+        print_scan("interact (cross)", ri);
+        printf("  checksum %lld/%lld/%lld\n", rr.checksum, rc.checksum, ri.checksum);
+    }
+
+#if defined(__linux__)
+    if (perf_fd >= 0) close(perf_fd);
+#endif
+    LayeredMap_Shutdown(&m);
+    return 0;
+}
+
+// ---------- Door transitions ----------
+
+#define DOOR_TRIPS 8
+#define DOOR_APPROACH_FRAMES 30   // frames spent walking up to the door
+
+static int bench_door(const char* a, const char* b)
+{
+    const char* maps[2] = { a, b };
+    LayeredMap cur;
+    memset(&cur, 0, sizeof(cur));
+    if (!LayeredMap_LoadFromFile(&cur, a)) return 1;
+
+    // Old path: the frame that uses the door loads the map itself.
+    double sync_worst = 0.0, sync_total = 0.0;
+    for (int trip = 0; trip < DOOR_TRIPS; ++trip)
+    {
+        const char* target = maps[(trip + 1) & 1];
+        const double t0 = now_sec();
+        LayeredMap_Shutdown(&cur);
+        if (!LayeredMap_LoadFromFile(&cur, target)) return 1;
+        (void)LayeredMap_Pack(&cur);
+        const double dt = now_sec() - t0;
+        sync_total += dt;
+        if (dt > sync_worst) sync_worst = dt;
+    }
+
+    MapPreload* pre = MapPreload_Create();
+    if (!pre) return 1;
+
+    // New path: request while approaching, swap on use, 60 Hz frames.
+    double pre_worst = 0.0, pre_total = 0.0;
+    int waited = 0;
+    for (int trip = 0; trip < DOOR_TRIPS; ++trip)
+    {
+        const char* target = maps[(trip + 1) & 1];
+        bool swapped = false;
+        for (int frame = 0; !swapped; ++frame)
+        {
+            const double t0 = now_sec();
+            MapPreload_Request(pre, target);
+            if (frame >= DOOR_APPROACH_FRAMES &&
+                MapPreload_State(pre, target) != MAP_PRELOAD_LOADING)
+            {
+                LayeredMap next;
+                memset(&next, 0, sizeof(next));
+                if (!MapPreload_Take(pre, target, &next)) return 1;
+                LayeredMap_Shutdown(&cur);
+                cur = next;
+                swapped = true;
+            }
+            else if (frame >= DOOR_APPROACH_FRAMES)
+            {
+                waited++;
+            }
+            const double dt = now_sec() - t0;
+            if (swapped) pre_total += dt;
+            if (dt > pre_worst) pre_worst = dt;
+            SDL_Delay(16);
+        }
+    }
+
+    MapPreload_Destroy(pre);
+
+    // Cache: the map being left is parked, the trip back only swaps.
+    MapCache* cache = MapCache_Create(MAP_CACHE_DEFAULT_BUDGET);
+    if (!cache) return 1;
+
+    double cache_worst = 0.0, cache_total = 0.0;
+    const char* cur_path = maps[0];
+    for (int trip = 0; trip < DOOR_TRIPS; ++trip)
+    {
+        const char* target = maps[(trip + 1) & 1];
+        const double t0 = now_sec();
+        LayeredMap next;
+        memset(&next, 0, sizeof(next));
+        if (!MapCache_Take(cache, target, &next))
+        {
+            if (!LayeredMap_LoadFromFile(&next, target)) return 1;
+            (void)LayeredMap_Pack(&next);
+        }
+        MapCache_Put(cache, cur_path, &cur);
+        cur = next;
+        cur_path = target;
+        const double dt = now_sec() - t0;
+        cache_total += dt;
+        if (dt > cache_worst) cache_worst = dt;
+    }
+
+    MapCacheStats st;
+    MapCache_GetStats(cache, &st);
+    MapCache_Destroy(cache);
+    LayeredMap_Shutdown(&cur);
+
+    printf("door trips: %d between %s and %s\n", DOOR_TRIPS, a, b);
+    printf("  synchronous load:  worst frame %8.3f ms, avg transition %8.3f ms\n",
+           sync_worst * 1000.0, sync_total * 1000.0 / DOOR_TRIPS);
+    printf("  preload + swap:    worst frame %8.3f ms, avg transition %8.3f ms, %d frames held\n",
+           pre_worst * 1000.0, pre_total * 1000.0 / DOOR_TRIPS, waited);
+    printf("  map cache:         worst frame %8.3f ms, avg transition %8.3f ms "
+           "(%u hits, %u misses, %u evictions, %zu KiB cached)\n",
+           cache_worst * 1000.0, cache_total * 1000.0 / DOOR_TRIPS,
+           st.hits, st.misses, st.evictions, st.bytes / 1024);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "parse") == 0)
+        return bench_parse(argc >= 3 ? atoi(argv[2]) : 4096);
+
+    if (argc >= 3 && strcmp(argv[1], "file") == 0)
+        return bench_files(argc - 2, argv + 2);
+
+    if (argc >= 2 && strcmp(argv[1], "packed") == 0)
+        return bench_packed(argc >= 3 ? atoi(argv[2]) : 4096);
+
+    if (argc >= 2 && strcmp(argv[1], "span") == 0)
+        return bench_span(argc >= 3 ? atoi(argv[2]) : 2048);
+
+    if (argc >= 2 && strcmp(argv[1], "edit") == 0)
+        return bench_edit(argc >= 3 ? atoi(argv[2]) : 2048);
+
+    if (argc >= 2 && strcmp(argv[1], "rect") == 0)
+        return bench_rect(argc >= 3 ? atoi(argv[2]) : 2048);
+
+    if (argc >= 2 && strcmp(argv[1], "rects") == 0)
+        return bench_rects(argc >= 3 ? atoi(argv[2]) : 2048, SDL_max(argc - 3, 0), argv + 3);
+
+    if (argc >= 2 && strcmp(argv[1], "regions") == 0)
+        return bench_regions(argc >= 3 ? atoi(argv[2]) : 2048);
+
+    if (argc >= 2 && strcmp(argv[1], "autotile") == 0)
+        return bench_autotile(argc >= 3 ? atoi(argv[2]) : 2048);
+
+    if (argc >= 2 && strcmp(argv[1], "gen") == 0)
+        return bench_gen(argc >= 3 ? atoi(argv[2]) : 4096);
+
+    if (argc >= 2 && strcmp(argv[1], "layout") == 0)
+        return bench_layout(argc >= 3 ? atoi(argv[2]) : 2048);
+
+    if (argc >= 4 && strcmp(argv[1], "door") == 0)
+        return bench_door(argv[2], argv[3]);
+
+    fprintf(stderr,
+            "usage: %s parse [max_size]\n"
+            "       %s file a.map3 [b.map3 ...]\n"
+            "       %s packed [size]\n"
+            "       %s span [size]\n"
+            "       %s edit [size]\n"
+            "       %s rect [size]\n"
+            "       %s rects [size] [a.map3 ...]\n"
+            "       %s regions [size]\n"
+            "       %s autotile [size]\n"
+            "       %s gen [size]\n"
+            "       %s layout [height]\n"
+            "       %s door a.map3 b.map3\n", argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0], argv[0]);
+    return 2;
+}
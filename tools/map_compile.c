@@ -0,0 +1,69 @@
+// tools/map_compile.c
+// Compile text .map3 files into the mapped binary format (.map3b).
+//
+//   map_compile assets/maps/test.map3 [more.map3 ...]
+//   map_compile -o out.map3b in.map3
+//
+// Solid tile ids from assets/tiles/tileset.props (when present) are folded
+// into the compiled collision layer, as the game does when parsing.
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "world/layered_map.h"
+#include "world/map_binary.h"
+#include "world/tile_props.h"
+
+static TileProps g_props;
+
+static bool compile_one(const char* in_path, const char* out_path)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+
+    if (!LayeredMap_LoadTextFile(&m, in_path))
+    {
+        fprintf(stderr, "map_compile: failed to parse %s\n", in_path);
+        return false;
+    }
+
+    const bool ok = MapBinary_Write(&m, out_path);
+    if (ok)
+        printf("%s -> %s (%dx%d ts=%d)\n", in_path, out_path, m.width, m.height, m.tile_size);
+
+    LayeredMap_Shutdown(&m);
+    return ok;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        fprintf(stderr, "usage: %s [-o out.map3b] in.map3 [in2.map3 ...]\n", argv[0]);
+        return 2;
+    }
+
+    TileProps_SetDefaults(&g_props);
+    if (TileProps_LoadFile(&g_props, TILE_PROPS_DEFAULT_PATH))
+        TileProps_SetActive(&g_props);
+
+    if (strcmp(argv[1], "-o") == 0)
+    {
+        if (argc != 4)
+        {
+            fprintf(stderr, "usage: %s -o out.map3b in.map3\n", argv[0]);
+            return 2;
+        }
+        return compile_one(argv[3], argv[2]) ? 0 : 1;
+    }
+
+    int failed = 0;
+    for (int i = 1; i < argc; ++i)
+    {
+        char out_path[256];
+        if (!MapBinary_PathFor(argv[i], out_path, sizeof(out_path)) || !compile_one(argv[i], out_path))
+            failed++;
+    }
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,121 @@
+// tools/map_encode.c
+// Re-encode text .map3 files with RLE / BITS sections (or back to plain) and
+// report the size and load-time change.
+//
+//   map_encode assets/maps/big.map3 [more.map3 ...]   rewrite in place
+//   map_encode -o out.map3 in.map3
+//   map_encode --plain ...                           expand to plain sections
+#include <SDL3/SDL.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "world/layered_map.h"
+#include "world/map_text.h"
+
+#define LOAD_REPS 5
+
+static double now_sec(void)
+{
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+static long long file_size(const char* path)
+{
+    SDL_PathInfo info;
+    if (!SDL_GetPathInfo(path, &info)) return -1;
+    return (long long)info.size;
+}
+
+// Best of LOAD_REPS text loads, in ms.
+static double load_ms(const char* path)
+{
+    double best = -1.0;
+    for (int i = 0; i < LOAD_REPS; ++i)
+    {
+        LayeredMap m;
+        memset(&m, 0, sizeof(m));
+
+        const double t0 = now_sec();
+        const bool ok = LayeredMap_LoadTextFile(&m, path);
+        const double dt = (now_sec() - t0) * 1000.0;
+
+        LayeredMap_Shutdown(&m);
+        if (!ok) return -1.0;
+        if (best < 0.0 || dt < best) best = dt;
+    }
+    return best;
+}
+
+static bool encode_one(const char* in_path, const char* out_path, bool encode)
+{
+    LayeredMap m;
+    memset(&m, 0, sizeof(m));
+
+    if (!LayeredMap_LoadTextFile(&m, in_path))
+    {
+        fprintf(stderr, "map_encode: failed to parse %s\n", in_path);
+        return false;
+    }
+
+    const long long old_size = file_size(in_path);
+    const double old_ms = load_ms(in_path);
+
+    // Write beside the target, then replace it (in_path may be out_path).
+    char tmp_path[272];
+    SDL_snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", out_path);
+
+    SDL_IOStream* io = SDL_IOFromFile(tmp_path, "wb");
+    bool ok = io && MapText_Write(&m, io, encode);
+    if (io && !SDL_CloseIO(io)) ok = false;
+    LayeredMap_Shutdown(&m);
+
+    if (ok) ok = SDL_RenamePath(tmp_path, out_path);
+    if (!ok)
+    {
+        fprintf(stderr, "map_encode: cannot write %s\n", out_path);
+        SDL_RemovePath(tmp_path);
+        return false;
+    }
+
+    const long long new_size = file_size(out_path);
+    const double new_ms = load_ms(out_path);
+
+    printf("%s -> %s: %lld -> %lld bytes (%.1f%%), load %.3f -> %.3f ms\n",
+           in_path, out_path, old_size, new_size,
+           old_size > 0 ? 100.0 * (double)new_size / (double)old_size : 0.0,
+           old_ms, new_ms);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    bool encode = true;
+    int first = 1;
+    if (argc > 1 && strcmp(argv[1], "--plain") == 0)
+    {
+        encode = false;
+        first = 2;
+    }
+
+    if (argc - first < 1)
+    {
+        fprintf(stderr, "usage: %s [--plain] [-o out.map3] in.map3 [in2.map3 ...]\n", argv[0]);
+        return 2;
+    }
+
+    if (strcmp(argv[first], "-o") == 0)
+    {
+        if (argc - first != 3)
+        {
+            fprintf(stderr, "usage: %s [--plain] -o out.map3 in.map3\n", argv[0]);
+            return 2;
+        }
+        return encode_one(argv[first + 2], argv[first + 1], encode) ? 0 : 1;
+    }
+
+    int failed = 0;
+    for (int i = first; i < argc; ++i)
+        if (!encode_one(argv[i], argv[i], encode)) failed++;
+
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,667 @@
+// tools/render_bench.c
+// Rendering benchmarks on SDL's software renderer (offscreen surface, no window).
+//
+//   render_bench tiles [w h] [size]   ground + deco of a generated size x size map (default
+//                                     1920x1080, 1024): one SDL_RenderTexture per tile vs one
+//                                     SDL_RenderGeometry per layer vs cached chunk textures
+//   render_bench rects [w h] [size]   the F1 debug view: wall placeholders, collision overlay and
+//                                     ENTITY_MAX feet boxes, one call per rect vs RectBatch
+//   render_bench mixed [w h] [size]   ground rows Y-sorted with ENTITY_MAX sprites: tileset and
+//                                     sprite sheet in separate textures vs one atlas
+//   render_bench text [w h]            the interaction HUD (prompt, dialog line, close hint):
+//                                     TTF rasterization per call vs a string texture cache
+//                                     vs UIText's glyph atlas
+#include <SDL3/SDL.h>
+#include <SDL3_ttf/SDL_ttf.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "game/entity_system.h"
+#include "render/atlas.h"
+#include "render/chunk_cache.h"
+#include "render/rect_batch.h"
+#include "render/tile_batch.h"
+#include "ui/text_cache.h"
+#include "ui/ui_text.h"
+#include "world/layered_map.h"
+#include "world/map_gen.h"
+
+#define SHEET_COLS 8
+#define SPRITES    12   // cells in the sprite sheet (3 x 4)
+#define FRAMES     240
+#define HUD_FRAMES 2000
+
+static double now_sec(void)
+{
+    return (double)SDL_GetPerformanceCounter() / (double)SDL_GetPerformanceFrequency();
+}
+
+// ---------- Setup ----------
+
+typedef struct Bench
+{
+    SDL_Surface* target;
+    SDL_Renderer* r;
+    Atlas atlas;        // tileset (ids = map ids), then the sprite sheet
+    int sprite_first;
+    LayeredMap map;
+    int w, h;
+} Bench;
+
+static void bench_close(Bench* b)
+{
+    LayeredMap_Shutdown(&b->map);
+    Atlas_Destroy(&b->atlas);
+    if (b->r) SDL_DestroyRenderer(b->r);
+    if (b->target) SDL_DestroySurface(b->target);
+}
+
+// Flat-colored sheet with an inset per cell, so misplaced texture
+// coordinates show up in the image comparison.
+static SDL_Surface* make_sheet(int cols, int rows, int ts, int salt)
+{
+    SDL_Surface* s = SDL_CreateSurface(cols * ts, rows * ts, SDL_PIXELFORMAT_RGBA8888);
+    if (!s) return NULL;
+
+    const SDL_PixelFormatDetails* fmt = SDL_GetPixelFormatDetails(s->format);
+    for (int i = 0; i < cols * rows; ++i)
+    {
+        const int c = i + salt;
+        const int x = (i % cols) * ts, y = (i / cols) * ts;
+        SDL_Rect outer = { x, y, ts, ts };
+        SDL_Rect inner = { x + ts / 4, y + ts / 4, ts / 2, ts / 2 };
+        SDL_FillSurfaceRect(s, &outer, SDL_MapRGBA(fmt, NULL, (Uint8)(40 + c * 29), (Uint8)(90 + c * 13), (Uint8)(c * 53), 255));
+        SDL_FillSurfaceRect(s, &inner, SDL_MapRGBA(fmt, NULL, (Uint8)(c * 7), 255, 255, 255));
+    }
+    return s;
+}
+
+// Atlas holding the tileset and/or the sprite sheet; returns the sprite
+// sheet's first id (or 1 when only the tileset was asked for), 0 on failure.
+static int make_atlas(Atlas* a, SDL_Renderer* r, int ts, bool tiles, bool sprites)
+{
+    int first = 1;
+    if (tiles && !Atlas_AddSurface(a, "tiles", make_sheet(SHEET_COLS, SHEET_COLS, ts, 0), ts, ts)) return 0;
+    if (sprites && !(first = Atlas_AddSurface(a, "sprites", make_sheet(3, SPRITES / 3, ts, 100), ts, ts))) return 0;
+    return Atlas_Build(a, r) ? first : 0;
+}
+
+static bool bench_open(Bench* b, int w, int h, int size)
+{
+    memset(b, 0, sizeof(*b));
+    b->w = w;
+    b->h = h;
+
+    MapGenParams p;
+    MapGen_DefaultParams(&p, 2024u, size, size);
+    if (!MapGen_Generate(&b->map, &p, SDL_GetNumLogicalCPUCores()))
+    {
+        fprintf(stderr, "render_bench: MapGen_Generate failed\n");
+        return false;
+    }
+
+    b->target = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+    b->r = b->target ? SDL_CreateSoftwareRenderer(b->target) : NULL;
+    b->sprite_first = b->r ? make_atlas(&b->atlas, b->r, b->map.tile_size, true, true) : 0;
+    if (!b->sprite_first)
+    {
+        fprintf(stderr, "render_bench: software renderer setup failed: %s\n", SDL_GetError());
+        bench_close(b);
+        return false;
+    }
+    return true;
+}
+
+// Camera for frame f: a diagonal pan across the map
+static void frame_view(const Bench* b, int f, float* cam_x, float* cam_y,
+                       int* tx0, int* ty0, int* tx1, int* ty1)
+{
+    const int ts = b->map.tile_size;
+    const float max_x = (float)SDL_max(b->map.width * ts - b->w, 1);
+    const float max_y = (float)SDL_max(b->map.height * ts - b->h, 1);
+    *cam_x = SDL_fmodf((float)f * 7.25f, max_x);
+    *cam_y = SDL_fmodf((float)f * 4.5f, max_y);
+
+    *tx0 = (int)(*cam_x / (float)ts);
+    *ty0 = (int)(*cam_y / (float)ts);
+    *tx1 = (int)((*cam_x + (float)b->w) / (float)ts) + 1;
+    *ty1 = (int)((*cam_y + (float)b->h) / (float)ts) + 1;
+    (void)LayeredMap_ClipRect(&b->map, tx0, ty0, tx1, ty1);
+}
+
+static uint64_t image_hash(const SDL_Surface* s)
+{
+    uint64_t h = 1469598103934665603ull;
+    for (int y = 0; y < s->h; ++y)
+    {
+        const Uint32* row = (const Uint32*)(const void*)((const Uint8*)s->pixels + (size_t)y * (size_t)s->pitch);
+        for (int x = 0; x < s->w; ++x) h = (h ^ (row[x] & 0xFFFFFFu)) * 1099511628211ull;
+    }
+    return h;
+}
+
+// ---------- Tile layers ----------
+
+typedef enum TileMode
+{
+    TILES_EACH = 0,   // SDL_RenderTexture per tile
+    TILES_BATCH,      // TileBatch, one SDL_RenderGeometry per layer
+    TILES_CHUNKS,     // ChunkCache over batched layers
+    TILES_MODE_COUNT
+} TileMode;
+
+typedef struct TileDraw
+{
+    Bench* b;
+    TileMode mode;
+    TileBatch batch;
+    unsigned calls;   // per-tile draws (TILES_EACH)
+} TileDraw;
+
+static void draw_layers(void* user, SDL_Renderer* r, int tx0, int ty0, int tx1, int ty1,
+                        float org_x, float org_y)
+{
+    TileDraw* d = (TileDraw*)user;
+    const LayeredMap* m = &d->b->map;
+    const int ts = m->tile_size;
+    const float tsf = (float)ts;
+
+    const LayeredMapLayer layers[2] = { MAP_LAYER_GROUND, MAP_LAYER_DECO };
+    int buf[LAYERED_MAP_SPAN_MAX];
+    for (int l = 0; l < 2; ++l)
+    {
+        if (d->mode != TILES_EACH) TileBatch_Begin(&d->batch, r, &d->b->atlas);
+
+        for (int ty = ty0; ty < ty1; ++ty)
+        {
+            for (int x0 = tx0; x0 < tx1; x0 += LAYERED_MAP_SPAN_MAX)
+            {
+                const int count = SDL_min(tx1 - x0, LAYERED_MAP_SPAN_MAX);
+                const int* row = LayeredMap_Row(m, layers[l], x0, ty, count, buf);
+                for (int i = 0; i < count; ++i)
+                {
+                    const int id = row[i];
+                    if (id <= 0) continue;
+
+                    const float dx = (float)((x0 + i) * ts) - org_x;
+                    const float dy = (float)(ty * ts) - org_y;
+                    if (d->mode != TILES_EACH)
+                    {
+                        TileBatch_Add(&d->batch, id, dx, dy);
+                        continue;
+                    }
+
+                    const AtlasEntry* e = Atlas_Get(&d->b->atlas, id);
+                    if (!e) continue;
+                    SDL_FRect dst = { dx, dy, tsf, tsf };
+                    SDL_RenderTexture(r, d->b->atlas.pages[e->page], &e->src, &dst);
+                    d->calls++;
+                }
+            }
+        }
+
+        if (d->mode != TILES_EACH) TileBatch_Flush(&d->batch);
+    }
+}
+
+static int bench_tiles(int w, int h, int size)
+{
+    Bench b;
+    if (!bench_open(&b, w, h, size)) return 1;
+
+    static const char* names[TILES_MODE_COUNT] = { "RenderTexture per tile", "RenderGeometry per layer", "chunk cache" };
+    printf("software renderer %dx%d, %dx%d map, %d px tiles, %d frames panning:\n",
+           w, h, size, size, b.map.tile_size, FRAMES);
+
+    uint64_t still[TILES_MODE_COUNT];
+    for (int mode = 0; mode < TILES_MODE_COUNT; ++mode)
+    {
+        TileDraw d;
+        memset(&d, 0, sizeof(d));
+        d.b = &b;
+        d.mode = (TileMode)mode;
+        ChunkCache* cache = mode == TILES_CHUNKS ? ChunkCache_Create() : NULL;
+
+        // One extra untimed frame back at the start of the pan for the image check
+        unsigned calls = 0, rebuilt = 0;
+        double ms = 0.0;
+        const double t0 = now_sec();
+        for (int f = 0; f <= FRAMES; ++f)
+        {
+            if (f == FRAMES) ms = (now_sec() - t0) * 1000.0 / FRAMES;
+
+            float cam_x, cam_y;
+            int tx0, ty0, tx1, ty1;
+            frame_view(&b, f % FRAMES, &cam_x, &cam_y, &tx0, &ty0, &tx1, &ty1);
+
+            SDL_SetRenderDrawColor(b.r, 0, 0, 0, 255);
+            SDL_RenderClear(b.r);
+
+            const unsigned before = d.calls + d.batch.draw_calls;
+            if (cache)
+            {
+                ChunkCache_Draw(cache, b.r, &b.map, tx0, ty0, tx1, ty1, cam_x, cam_y, draw_layers, &d);
+                ChunkCacheStats st;
+                ChunkCache_GetStats(cache, &st);
+                if (f < FRAMES) { calls += (unsigned)st.blits; rebuilt += (unsigned)st.rebuilt; }
+            }
+            else
+            {
+                draw_layers(&d, b.r, tx0, ty0, tx1, ty1, cam_x, cam_y);
+                if (f < FRAMES) calls += d.calls + d.batch.draw_calls - before;
+            }
+            SDL_FlushRenderer(b.r);
+        }
+        still[mode] = image_hash(b.target);
+
+        printf("  %-26s %8.1f draw calls/frame %8.2f ms/frame", names[mode], (double)calls / FRAMES, ms);
+        if (cache) printf("  (%u chunk redraws)", rebuilt);
+        printf("%s\n", mode > 0 && still[mode] != still[0] ? "  image differs" : "");
+
+        ChunkCache_Destroy(cache);
+        TileBatch_Free(&d.batch);
+    }
+
+    bench_close(&b);
+    return 0;
+}
+
+// Boxes scattered over the area the pan covers, as many as the entity
+// system holds, sorted by y.
+static void scatter_boxes(SDL_FRect* out, int n, int w, int h, float bw, float bh)
+{
+    uint32_t seed = 99u;
+    for (int i = 0; i < n; ++i)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        const float x = (float)((seed >> 8) % (uint32_t)(w + FRAMES * 8));
+        seed = seed * 1664525u + 1013904223u;
+        const float y = (float)((seed >> 8) % (uint32_t)(h + FRAMES * 5));
+
+        int j = i;
+        for (; j > 0 && out[j - 1].y > y; --j) out[j] = out[j - 1];
+        out[j] = (SDL_FRect){ x, y, bw, bh };
+    }
+}
+
+// ---------- Debug rects ----------
+
+// One debug-mode frame of rects; returns the draw calls made.
+static unsigned draw_debug_rects(Bench* b, RectBatch* batch, const SDL_FRect* feet, int nfeet,
+                                 int tx0, int ty0, int tx1, int ty1, float cam_x, float cam_y)
+{
+    SDL_Renderer* r = b->r;
+    const int ts = b->map.tile_size;
+    const float tsf = (float)ts;
+    unsigned calls = 0;
+    if (batch) batch->draw_calls = 0;
+
+    // Wall placeholders, then the overlay over every solid tile
+    static const SDL_Color colors[2] = { { 70, 70, 90, 255 }, { 255, 0, 0, 70 } };
+    int buf[LAYERED_MAP_SPAN_MAX];
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        SDL_SetRenderDrawBlendMode(r, pass ? SDL_BLENDMODE_BLEND : SDL_BLENDMODE_NONE);
+        if (batch) RectBatch_Begin(batch, r, RECT_BATCH_FILL, colors[pass]);
+        else SDL_SetRenderDrawColor(r, colors[pass].r, colors[pass].g, colors[pass].b, colors[pass].a);
+
+        for (int ty = ty0; ty < ty1; ++ty)
+        {
+            for (int x0 = tx0; x0 < tx1; x0 += LAYERED_MAP_SPAN_MAX)
+            {
+                const int count = SDL_min(tx1 - x0, LAYERED_MAP_SPAN_MAX);
+                const int* solid = LayeredMap_Row(&b->map, MAP_LAYER_COLL, x0, ty, count, buf);
+                for (int i = 0; i < count; ++i)
+                {
+                    if (!solid[i]) continue;
+                    SDL_FRect rc = { (float)((x0 + i) * ts) - cam_x, (float)(ty * ts) - cam_y, tsf, tsf };
+                    if (batch) RectBatch_Add(batch, rc.x, rc.y, rc.w, rc.h);
+                    else { SDL_RenderFillRect(r, &rc); calls++; }
+                }
+            }
+        }
+        if (batch) RectBatch_Flush(batch);
+    }
+
+    // Feet boxes: the old path set color and blend mode around each one
+    if (batch) RectBatch_Begin(batch, r, RECT_BATCH_OUTLINE, (SDL_Color){ 0, 255, 0, 160 });
+    for (int i = 0; i < nfeet; ++i)
+    {
+        if (batch)
+        {
+            RectBatch_Add(batch, feet[i].x - cam_x, feet[i].y - cam_y, feet[i].w, feet[i].h);
+            continue;
+        }
+        SDL_FRect rc = { feet[i].x - cam_x, feet[i].y - cam_y, feet[i].w, feet[i].h };
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_BLEND);
+        SDL_SetRenderDrawColor(r, 0, 255, 0, 160);
+        SDL_RenderRect(r, &rc);
+        SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+        calls++;
+    }
+    if (batch) RectBatch_Flush(batch);
+
+    SDL_SetRenderDrawBlendMode(r, SDL_BLENDMODE_NONE);
+    return batch ? batch->draw_calls : calls;
+}
+
+static int bench_rects(int w, int h, int size)
+{
+    Bench b;
+    if (!bench_open(&b, w, h, size)) return 1;
+
+    const int ts = b.map.tile_size;
+    SDL_FRect feet[ENTITY_MAX];
+    scatter_boxes(feet, ENTITY_MAX, w, h, (float)ts * 0.6f, (float)ts * 0.3f);
+
+    printf("software renderer %dx%d, %dx%d map, debug view (walls + overlay + %d feet boxes), %d frames:\n",
+           w, h, size, size, ENTITY_MAX, FRAMES);
+
+    static RectBatch batch;
+    uint64_t still[2];
+    for (int batched = 0; batched < 2; ++batched)
+    {
+        unsigned calls = 0;
+        double ms = 0.0;
+        const double t0 = now_sec();
+        for (int f = 0; f <= FRAMES; ++f)
+        {
+            if (f == FRAMES) ms = (now_sec() - t0) * 1000.0 / FRAMES;
+
+            float cam_x, cam_y;
+            int tx0, ty0, tx1, ty1;
+            frame_view(&b, f % FRAMES, &cam_x, &cam_y, &tx0, &ty0, &tx1, &ty1);
+
+            SDL_SetRenderDrawColor(b.r, 0, 0, 0, 255);
+            SDL_RenderClear(b.r);
+            const unsigned n = draw_debug_rects(&b, batched ? &batch : NULL, feet, ENTITY_MAX,
+                                                tx0, ty0, tx1, ty1, cam_x, cam_y);
+            if (f < FRAMES) calls += n;
+            SDL_FlushRenderer(b.r);
+        }
+        still[batched] = image_hash(b.target);
+
+        printf("  %-26s %8.1f draw calls/frame %8.2f ms/frame%s\n",
+               batched ? "RectBatch" : "one call per rect", (double)calls / FRAMES, ms,
+               batched && still[1] != still[0] ? "  image differs" : "");
+    }
+
+    bench_close(&b);
+    return 0;
+}
+
+// ---------- Mixed scene ----------
+
+// Ground row by row with the sprites standing on each row drawn right after
+// it, as a Y-sorted scene does. Returns the SDL_RenderGeometry calls made.
+static unsigned draw_mixed(Bench* b, TileBatch* batch, const Atlas* tiles, const Atlas* sprites,
+                           const SDL_FRect* boxes, int nboxes,
+                           int tx0, int ty0, int tx1, int ty1, float cam_x, float cam_y)
+{
+    const LayeredMap* m = &b->map;
+    const int ts = m->tile_size;
+    const int sprite_first = sprites == tiles ? b->sprite_first : 1;
+    batch->draw_calls = 0;
+
+    int buf[LAYERED_MAP_SPAN_MAX];
+    int next = 0;
+    while (next < nboxes && boxes[next].y + boxes[next].h <= (float)(ty0 * ts)) next++;
+
+    for (int ty = ty0; ty < ty1; ++ty)
+    {
+        TileBatch_Begin(batch, b->r, tiles);
+        for (int x0 = tx0; x0 < tx1; x0 += LAYERED_MAP_SPAN_MAX)
+        {
+            const int count = SDL_min(tx1 - x0, LAYERED_MAP_SPAN_MAX);
+            const int* row = LayeredMap_Row(m, MAP_LAYER_GROUND, x0, ty, count, buf);
+            for (int i = 0; i < count; ++i)
+                TileBatch_Add(batch, row[i], (float)((x0 + i) * ts) - cam_x, (float)(ty * ts) - cam_y);
+        }
+
+        // Sprites whose feet are on this row
+        TileBatch_Begin(batch, b->r, sprites);
+        for (; next < nboxes && boxes[next].y + boxes[next].h <= (float)((ty + 1) * ts); ++next)
+            TileBatch_Add(batch, sprite_first + next % SPRITES, boxes[next].x - cam_x, boxes[next].y - cam_y);
+    }
+    TileBatch_Flush(batch);
+    return batch->draw_calls;
+}
+
+static int bench_mixed(int w, int h, int size)
+{
+    Bench b;
+    if (!bench_open(&b, w, h, size)) return 1;
+
+    const int ts = b.map.tile_size;
+    Atlas split[2];
+    memset(split, 0, sizeof(split));
+    if (!make_atlas(&split[0], b.r, ts, true, false) || !make_atlas(&split[1], b.r, ts, false, true))
+    {
+        fprintf(stderr, "render_bench: atlas setup failed\n");
+        Atlas_Destroy(&split[0]);
+        bench_close(&b);
+        return 1;
+    }
+
+    SDL_FRect boxes[ENTITY_MAX];
+    scatter_boxes(boxes, ENTITY_MAX, w, h, (float)ts, (float)ts);
+
+    printf("software renderer %dx%d, %dx%d map, ground rows Y-sorted with %d sprites, %d frames:\n",
+           w, h, size, size, ENTITY_MAX, FRAMES);
+
+    static TileBatch batch;
+    uint64_t still[2];
+    for (int unified = 0; unified < 2; ++unified)
+    {
+        const Atlas* tiles = unified ? &b.atlas : &split[0];
+        const Atlas* sprites = unified ? &b.atlas : &split[1];
+
+        unsigned calls = 0;
+        double ms = 0.0;
+        const double t0 = now_sec();
+        for (int f = 0; f <= FRAMES; ++f)
+        {
+            if (f == FRAMES) ms = (now_sec() - t0) * 1000.0 / FRAMES;
+
+            float cam_x, cam_y;
+            int tx0, ty0, tx1, ty1;
+            frame_view(&b, f % FRAMES, &cam_x, &cam_y, &tx0, &ty0, &tx1, &ty1);
+
+            SDL_SetRenderDrawColor(b.r, 0, 0, 0, 255);
+            SDL_RenderClear(b.r);
+            const unsigned n = draw_mixed(&b, &batch, tiles, sprites, boxes, ENTITY_MAX,
+                                          tx0, ty0, tx1, ty1, cam_x, cam_y);
+            if (f < FRAMES) calls += n;
+            SDL_FlushRenderer(b.r);
+        }
+        still[unified] = image_hash(b.target);
+
+        printf("  %-26s %8.1f draw calls/frame %8.2f ms/frame%s\n",
+               unified ? "one atlas" : "separate textures", (double)calls / FRAMES, ms,
+               unified && still[1] != still[0] ? "  image differs" : "");
+    }
+
+    TileBatch_Free(&batch);
+    Atlas_Destroy(&split[0]);
+    Atlas_Destroy(&split[1]);
+    bench_close(&b);
+    return 0;
+}
+
+// ---------- HUD text ----------
+
+static const char* kHudFont1 = "assets/fonts/DejaVuSans.ttf";
+static const char* kHudFont2 = "/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf";
+
+static const char* kHudLines[3] = {
+    "Press E to interact",
+    "The old well is dry. Someone has scratched a map into its stones.",
+    "E / Esc: Close",
+};
+
+// The pre-atlas UIText path: rasterize, upload, draw and free every string,
+// measuring by rasterizing as well.
+static void ttf_line(SDL_Renderer* r, TTF_Font* font, float x, float y, const char* text, int* out_w)
+{
+    const SDL_Color fg = { 240, 240, 240, 255 };
+    SDL_Surface* s = TTF_RenderText_Blended(font, text, 0, fg);
+    if (!s) return;
+    if (out_w)
+    {
+        *out_w = s->w;
+        SDL_DestroySurface(s);
+        return;
+    }
+
+    SDL_Texture* t = SDL_CreateTextureFromSurface(r, s);
+    SDL_DestroySurface(s);
+    if (!t) return;
+
+    float tw = 0.0f, th = 0.0f;
+    SDL_GetTextureSize(t, &tw, &th);
+    SDL_FRect dst = { x, y, tw, th };
+    SDL_RenderTexture(r, t, NULL, &dst);
+    SDL_DestroyTexture(t);
+}
+
+typedef enum TextMode
+{
+    TEXT_TTF = 0,     // TTF render + upload per string
+    TEXT_CACHE,       // TextCache, one upload per distinct string
+    TEXT_ATLAS,       // UIText: glyph atlas, one SDL_RenderGeometry per string
+    TEXT_MODE_COUNT
+} TextMode;
+
+static void cached_line(SDL_Renderer* r, TextCache* cache, TTF_Font* font, float x, float y, const char* text, int* out_w)
+{
+    const SDL_Color fg = { 240, 240, 240, 255 };
+    SDL_Texture* t = TextCache_Get(cache, r, font, text, fg);
+    if (!t) return;
+
+    float tw = 0.0f, th = 0.0f;
+    SDL_GetTextureSize(t, &tw, &th);
+    if (out_w)
+    {
+        *out_w = (int)tw;
+        return;
+    }
+    SDL_FRect dst = { x, y, tw, th };
+    SDL_RenderTexture(r, t, NULL, &dst);
+}
+
+// One HUD frame: the prompt centered by its measured width, then the dialog
+// box lines. Returns the strings drawn.
+static int draw_hud(SDL_Renderer* r, TextMode mode, TTF_Font* font, TextCache* cache, int w, int h, int f)
+{
+    const float jitter = (float)(f % 7);
+    int tw = 0, th = 0;
+    if (mode == TEXT_TTF) ttf_line(r, font, 0.0f, 0.0f, kHudLines[0], &tw);
+    else if (mode == TEXT_CACHE) cached_line(r, cache, font, 0.0f, 0.0f, kHudLines[0], &tw);
+    else (void)UIText_MeasureLine(kHudLines[0], &tw, &th);
+
+    const float px = (float)w * 0.5f - (float)tw * 0.5f, py = (float)h - 190.0f;
+    const float bx = 36.0f + jitter, by = (float)h - 150.0f;
+    for (int i = 0; i < 3; ++i)
+    {
+        const float x = i == 0 ? px : bx;
+        const float y = i == 0 ? py : (i == 1 ? by : by + 116.0f);
+        if (mode == TEXT_TTF) ttf_line(r, font, x, y, kHudLines[i], NULL);
+        else if (mode == TEXT_CACHE) cached_line(r, cache, font, x, y, kHudLines[i], NULL);
+        else UIText_DrawLine(r, x, y, kHudLines[i]);
+    }
+    return 3;
+}
+
+static int bench_text(int w, int h)
+{
+    SDL_Surface* target = SDL_CreateSurface(w, h, SDL_PIXELFORMAT_XRGB8888);
+    SDL_Renderer* r = target ? SDL_CreateSoftwareRenderer(target) : NULL;
+    TTF_Font* font = NULL;
+    if (r && UIText_Init(r))
+    {
+        font = TTF_OpenFont(kHudFont1, 20.0f);
+        if (!font) font = TTF_OpenFont(kHudFont2, 20.0f);
+    }
+    if (!font)
+    {
+        fprintf(stderr, "render_bench: text setup failed (font at %s?): %s\n", kHudFont1, SDL_GetError());
+        UIText_Shutdown();
+        if (r) SDL_DestroyRenderer(r);
+        if (target) SDL_DestroySurface(target);
+        return 1;
+    }
+
+    printf("software renderer %dx%d, HUD of %d strings, %d frames:\n", w, h, 3, HUD_FRAMES);
+
+    static const char* names[TEXT_MODE_COUNT] = { "TTF render per call", "string texture cache", "glyph atlas (UIText)" };
+    TextCache* cache = TextCache_Create(TEXT_CACHE_DEFAULT_BUDGET);
+    for (int mode = 0; mode < TEXT_MODE_COUNT; ++mode)
+    {
+        int strings = 0;
+        const double t0 = now_sec();
+        for (int f = 0; f < HUD_FRAMES; ++f)
+        {
+            SDL_SetRenderDrawColor(r, 0, 0, 0, 255);
+            SDL_RenderClear(r);
+            strings += draw_hud(r, (TextMode)mode, font, cache, w, h, f);
+            SDL_FlushRenderer(r);
+        }
+        const double ms = (now_sec() - t0) * 1000.0;
+
+        printf("  %-26s %8.1f strings/ms %8.3f ms/frame", names[mode], (double)strings / ms, ms / HUD_FRAMES);
+        if (mode == TEXT_CACHE)
+        {
+            TextCacheStats st;
+            TextCache_GetStats(cache, &st);
+            printf("  %u hits, %u misses (%.1f%%)", st.hits, st.misses,
+                   100.0 * st.hits / (double)SDL_max(st.hits + st.misses, 1u));
+        }
+        printf("\n");
+    }
+
+    TextCache_Destroy(cache);
+    TTF_CloseFont(font);
+    UIText_Shutdown();
+    SDL_DestroyRenderer(r);
+    SDL_DestroySurface(target);
+    return 0;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc >= 2 && strcmp(argv[1], "tiles") == 0)
+    {
+        const int w = argc >= 4 ? atoi(argv[2]) : 1920;
+        const int h = argc >= 4 ? atoi(argv[3]) : 1080;
+        return bench_tiles(w, h, argc >= 5 ? atoi(argv[4]) : 1024);
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "rects") == 0)
+    {
+        const int w = argc >= 4 ? atoi(argv[2]) : 1920;
+        const int h = argc >= 4 ? atoi(argv[3]) : 1080;
+        return bench_rects(w, h, argc >= 5 ? atoi(argv[4]) : 1024);
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "mixed") == 0)
+    {
+        const int w = argc >= 4 ? atoi(argv[2]) : 1920;
+        const int h = argc >= 4 ? atoi(argv[3]) : 1080;
+        return bench_mixed(w, h, argc >= 5 ? atoi(argv[4]) : 1024);
+    }
+
+    if (argc >= 2 && strcmp(argv[1], "text") == 0)
+    {
+        const int w = argc >= 4 ? atoi(argv[2]) : 1920;
+        const int h = argc >= 4 ? atoi(argv[3]) : 1080;
+        return bench_text(w, h);
+    }
+
+    fprintf(stderr,
+            "usage: %s tiles [w h] [size]\n"
+            "       %s rects [w h] [size]\n"
+            "       %s mixed [w h] [size]\n"
+            "       %s text [w h]\n", argv[0], argv[0], argv[0], argv[0]);
+    return 2;
+}